@@ -3,12 +3,14 @@ from __future__ import annotations
 import hashlib
 import io
 import logging
+import math
 from pathlib import Path
 import re
+import struct
 
 from PIL import Image, UnidentifiedImageError
 
-from esphome import core, external_files
+from esphome import automation, core, external_files
 import esphome.codegen as cg
 from esphome.components.const import CONF_BYTE_ORDER
 import esphome.config_validation as cv
@@ -26,6 +28,7 @@ from esphome.const import (
     CONF_URL,
 )
 from esphome.core import CORE, HexInt
+from esphome.coroutine import coroutine_with_priority
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -76,6 +79,25 @@ MDI_SOURCES = {
 
 Image_ = image_ns.class_("Image")
 INSTANCE_TYPE = Image_
+AssetPack_ = image_ns.class_("AssetPack", cg.Component)
+ImageView_ = image_ns.class_(
+    "ImageView", cg.esphome_ns.namespace("display").class_("BaseImage")
+)
+PrefetchAction = image_ns.class_("PrefetchAction", automation.Action, cg.Component)
+
+CONF_ASSET_PACK = "asset_pack"
+CONF_ATLAS = "atlas"
+
+# Pack d'images externe : doit correspondre à asset_pack.h
+ASSET_PACK_MAGIC = 0x474D4945  # "EIMG"
+ASSET_PACK_VERSION = 1
+ASSET_PACK_ALIGNMENT = 16
+ASSET_PACK_HEADER = struct.Struct("<IHHI")
+ASSET_PACK_ENTRY = struct.Struct("<IIHHBBH")
+# Ordre de l'énumération C++ ImageType
+ASSET_PACK_TYPES = ("BINARY", "GRAYSCALE", "RGB", "RGB565")
+ASSET_PACK_PARTITION = "image_assets"
+ASSET_PACK_FILE = "image_assets.bin"
 
 
 def get_image_type_enum(type):
@@ -654,6 +676,166 @@ class SDImage : public Image {
 """
 
 
+def build_asset_pack(entries) -> bytes:
+    """
+    Construit le pack binaire : en-tête, index puis pixels alignés.
+    Chaque entrée est un tuple (data, width, height, type, transparency).
+    """
+
+    def pad(buffer):
+        buffer.extend(bytes(-len(buffer) % ASSET_PACK_ALIGNMENT))
+
+    pack = bytearray(ASSET_PACK_HEADER.size + ASSET_PACK_ENTRY.size * len(entries))
+    index = bytearray()
+    for data, width, height, img_type, transparency in entries:
+        pad(pack)
+        index.extend(
+            ASSET_PACK_ENTRY.pack(
+                len(pack),
+                len(data),
+                width,
+                height,
+                ASSET_PACK_TYPES.index(img_type),
+                TRANSPARENCY_TYPES.index(transparency),
+                0,
+            )
+        )
+        pack.extend(bytes(data))
+    header = ASSET_PACK_HEADER.pack(
+        ASSET_PACK_MAGIC, ASSET_PACK_VERSION, len(entries), len(pack)
+    )
+    pack[: len(header) + len(index)] = header + index
+    return bytes(pack)
+
+
+async def add_to_asset_pack(image, data, width, height, transparency, config):
+    """
+    Ajoute les pixels encodés au pack externe au lieu d'un tableau PROGMEM.
+    Le fichier est réécrit à chaque ajout, il est donc complet après la dernière image.
+    """
+    pack_data = CORE.data.setdefault(DOMAIN, {})
+    entries = pack_data.setdefault(CONF_ASSET_PACK, [])
+    path = Path(CORE.relative_build_path(ASSET_PACK_FILE))
+
+    if (pack := pack_data.get("asset_pack_var")) is None:
+        pack = cg.new_Pvariable(
+            core.ID("image_asset_pack", is_declaration=True, type=AssetPack_)
+        )
+        await cg.register_component(pack, {})
+        cg.add(pack.set_partition_label(ASSET_PACK_PARTITION))
+        if CORE.is_host:
+            cg.add(pack.set_file_path(str(path)))
+        pack_data["asset_pack_var"] = pack
+        _LOGGER.info(
+            f"Pack d'images externe: {path} (partition '{ASSET_PACK_PARTITION}' sur ESP32)"
+        )
+
+    index = len(entries)
+    entries.append(
+        (data, width, height, config[CONF_TYPE], transparency)
+    )
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_bytes(build_asset_pack(entries))
+    cg.add(pack.register_image(image, index))
+    return index
+
+
+def pack_atlas(sizes, align):
+    """
+    Rangement en étagères : icônes triées par hauteur décroissante, posées de
+    gauche à droite, nouvelle étagère quand la largeur de l'atlas est atteinte.
+    Les largeurs sont arrondies à align pixels (8 en BINARY : chaque ligne
+    d'icône commence sur un octet).
+    Retourne (largeur, hauteur, positions) avec positions dans l'ordre de sizes.
+    """
+
+    def round_up(value):
+        return -(-value // align) * align
+
+    area = sum(round_up(w) * h for w, h in sizes)
+    atlas_width = max(
+        max(round_up(w) for w, _ in sizes), round_up(math.ceil(math.sqrt(area)))
+    )
+    positions = [None] * len(sizes)
+    x = y = shelf_height = 0
+    for i in sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0])):
+        width, height = sizes[i]
+        if x + round_up(width) > atlas_width:
+            x = 0
+            y += shelf_height
+            shelf_height = 0
+        positions[i] = (x, y)
+        x += round_up(width)
+        shelf_height = max(shelf_height, height)
+    return atlas_width, y + shelf_height, positions
+
+
+def build_atlas(icons, img_type):
+    """
+    Copie les lignes encodées de chaque icône (data, width, height) dans un
+    buffer unique de largeur commune. Retourne (data, largeur, hauteur, positions).
+    """
+    align = 8 if img_type == "BINARY" else 1
+    atlas_width, atlas_height, positions = pack_atlas(
+        [(width, height) for _, width, height in icons], align
+    )
+    data, width, height = icons[0]
+    bpp = 1 if img_type == "BINARY" else len(data) // height * 8 // width
+    stride = (atlas_width * bpp + 7) // 8
+    atlas = bytearray(stride * atlas_height)
+    for (data, width, height), (x, y) in zip(icons, positions):
+        row_bytes = len(data) // height
+        offset = y * stride + x * bpp // 8
+        for row in range(height):
+            atlas[offset : offset + row_bytes] = bytes(
+                data[row * row_bytes : (row + 1) * row_bytes]
+            )
+            offset += stride
+    return atlas, atlas_width, atlas_height, positions
+
+
+@coroutine_with_priority(-100.0)
+async def write_atlases():
+    """
+    Émis après toutes les images : un tableau PROGMEM et une Image par
+    combinaison (type, transparence, ordre des octets), puis la région de chaque icône.
+    """
+    atlases = CORE.data[DOMAIN][CONF_ATLAS]
+    for index, ((img_type, transparency, _), icons) in enumerate(atlases.items()):
+        data, width, height, positions = build_atlas(
+            [(data, w, h) for _, data, w, h in icons], img_type
+        )
+        prog_arr = cg.progmem_array(
+            core.ID(f"image_atlas_{index}_data", is_declaration=True, type=cg.uint8),
+            [HexInt(x) for x in data],
+        )
+        atlas = cg.new_Pvariable(
+            core.ID(f"image_atlas_{index}", is_declaration=True, type=Image_),
+            prog_arr,
+            width,
+            height,
+            get_image_type_enum(img_type),
+            get_transparency_enum(transparency),
+        )
+        for (var, _, w, h), (x, y) in zip(icons, positions):
+            cg.add(var.set_region(atlas, x, y, w, h))
+        _LOGGER.info(
+            f"Atlas {img_type}/{transparency}: {len(icons)} icônes dans {width}x{height} ({len(data)} octets)"
+        )
+
+
+def add_to_atlas(image, data, width, height, transparency, config):
+    """
+    Réserve la place d'une icône dans l'atlas de son format ; l'atlas est
+    rangé et émis par write_atlases() une fois toutes les images connues.
+    """
+    atlases = CORE.data.setdefault(DOMAIN, {}).setdefault(CONF_ATLAS, {})
+    if not atlases:
+        CORE.add_job(write_atlases)
+    key = (config[CONF_TYPE], transparency, config.get(CONF_BYTE_ORDER))
+    atlases.setdefault(key, []).append((image, data, width, height))
+
+
 async def write_image(config, all_frames=False):
     """
     Fonction principale de traitement des images avec support complet pour cartes SD.
@@ -868,6 +1050,32 @@ async def write_local_image(config, all_frames=False):
         else:
             data = encoded_frames[0]
         
+        # Icône d'atlas : un ImageView sans données propres, sa région est
+        # renseignée par write_atlases(). Utilisable partout où un
+        # display::BaseImage est attendu (it.image() dans les lambdas)
+        if config.get(CONF_ATLAS):
+            if len(encoded_frames) > 1:
+                raise cv.Invalid("Animated images cannot be packed in an atlas")
+            var = cg.new_Pvariable(config[CONF_ID])
+            add_to_atlas(var, data, width, height, encoder.transparency, config)
+            return var
+
+        # Pixels dans le pack externe : l'image est créée sans données,
+        # data_start_ est renseigné au setup() une fois le pack projeté
+        if config.get(CONF_ASSET_PACK):
+            var = cg.new_Pvariable(
+                config[CONF_ID],
+                cg.nullptr,
+                width,
+                height,
+                get_image_type_enum(config[CONF_TYPE]),
+                get_transparency_enum(encoder.transparency),
+            )
+            await add_to_asset_pack(
+                var, data, width, height, encoder.transparency, config
+            )
+            return var
+
         # Génération du code C++
         rhs = [HexInt(x) for x in data]
         prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
@@ -986,12 +1194,29 @@ def validate_settings(value):
         raise cv.Invalid(
             f"Image format '{conf_type}' does not support byte order configuration"
         )
+    if value.get(CONF_ATLAS):
+        if value.get(CONF_ASSET_PACK):
+            raise cv.Invalid(
+                "An image cannot be both in the asset pack and in an atlas"
+            )
+        # Une icône d'atlas est un ImageView, pas une Image : typée dès la
+        # validation pour que les cv.use_id(Image_) (prefetch, LVGL, animation)
+        # la refusent au lieu d'échouer à la compilation C++
+        value[CONF_ID].type = ImageView_
     if file := value.get(CONF_FILE):
         file_path = str(file)
         
         # Pour les fichiers SD card, on évite la validation locale
         if is_sd_card_path(file_path):
             _LOGGER.info(f"SD card image configured: {file_path} - skipping local validation")
+            if value.get(CONF_ASSET_PACK):
+                raise cv.Invalid(
+                    f"SD card images cannot be stored in the asset pack. Image: {file_path}"
+                )
+            if value.get(CONF_ATLAS):
+                raise cv.Invalid(
+                    f"SD card images cannot be packed in an atlas. Image: {file_path}"
+                )
             # Validation spécifique pour SD card
             if CONF_RESIZE not in value:
                 raise cv.Invalid(
@@ -1028,6 +1253,8 @@ OPTIONS_SCHEMA = {
     cv.Optional(CONF_BYTE_ORDER): cv.one_of("BIG_ENDIAN", "LITTLE_ENDIAN", upper=True),
     cv.Optional(CONF_TRANSPARENCY, default=CONF_OPAQUE): validate_transparency(),
     cv.Optional(CONF_TYPE): validate_type(IMAGE_TYPE),
+    cv.Optional(CONF_ASSET_PACK, default=False): cv.boolean,
+    cv.Optional(CONF_ATLAS, default=False): cv.boolean,
 }
 
 OPTIONS = [key.schema for key in OPTIONS_SCHEMA]
@@ -1148,6 +1375,26 @@ def _config_schema(config):
 CONFIG_SCHEMA = _config_schema
 
 
+@automation.register_action(
+    "image.prefetch",
+    PrefetchAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_IMAGES): cv.ensure_list(cv.use_id(Image_)),
+        }
+    ),
+)
+async def image_prefetch_to_code(config, action_id, template_arg, args):
+    """
+    Précharge en tâche de fond toutes les images SD d'une page avant son affichage.
+    """
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_component(var, {})
+    images = [await cg.get_variable(image_id) for image_id in config[CONF_IMAGES]]
+    cg.add(var.set_images(images))
+    return var
+
+
 def validate_no_flash_memory_usage(config):
     """
     Valide qu'aucune donnée d'image SD ne sera stockée en flash memory.
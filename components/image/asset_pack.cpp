@@ -0,0 +1,176 @@
+#include "asset_pack.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_HOST
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace esphome {
+namespace image {
+
+static const char *const TAG = "image.asset_pack";
+
+void AssetPack::setup() {
+  if (!this->map_() || !this->validate_()) {
+    this->mark_failed();
+    return;
+  }
+
+  for (auto &reg : this->images_) {
+    const AssetPackEntry *entry = this->get_entry_(reg.index);
+    if (entry == nullptr) {
+      ESP_LOGE(TAG, "Image index %u not found in asset pack (%u images)", reg.index, this->count_);
+      continue;
+    }
+    // Le pack est flashé séparément du firmware : une entrée d'un autre format
+    // ferait lire les dessins au-delà de ses pixels
+    Image *image = reg.image;
+    if (entry->type != image->type_ || entry->transparency != image->transparency_ ||
+        entry->width != image->width_ || entry->height != image->height_) {
+      ESP_LOGE(TAG, "Image index %u: %ux%u type %u transparency %u in pack, %dx%d type %u transparency %u expected",
+               reg.index, entry->width, entry->height, entry->type, entry->transparency, image->width_,
+               image->height_, image->type_, image->transparency_);
+      continue;
+    }
+    const size_t expected = image->get_width_stride() * image->height_;
+    if (entry->size < expected) {
+      ESP_LOGE(TAG, "Image index %u: %u bytes in pack, %zu expected", reg.index, (unsigned) entry->size, expected);
+      continue;
+    }
+    image->set_data_start(this->base_ + entry->offset);
+  }
+}
+
+void AssetPack::dump_config() {
+  ESP_LOGCONFIG(TAG, "Image asset pack:");
+#ifdef USE_ESP32
+  ESP_LOGCONFIG(TAG, "  Partition: %s", this->partition_label_ != nullptr ? this->partition_label_ : "(none)");
+#endif
+#ifdef USE_HOST
+  ESP_LOGCONFIG(TAG, "  File: %s", this->file_path_ != nullptr ? this->file_path_ : "(none)");
+#endif
+  ESP_LOGCONFIG(TAG, "  Images: %u (%zu bytes mapped)", this->count_, this->size_);
+  ESP_LOGCONFIG(TAG, "  Registered: %zu", this->images_.size());
+}
+
+const uint8_t *AssetPack::get_data(uint16_t index) const {
+  const AssetPackEntry *entry = this->get_entry_(index);
+  if (entry == nullptr)
+    return nullptr;
+  return this->base_ + entry->offset;
+}
+
+const AssetPackEntry *AssetPack::get_entry_(uint16_t index) const {
+  if (this->base_ == nullptr || index >= this->count_)
+    return nullptr;
+  return reinterpret_cast<const AssetPackEntry *>(this->base_ + sizeof(AssetPackHeader)) + index;
+}
+
+bool AssetPack::validate_() {
+  if (this->size_ < sizeof(AssetPackHeader)) {
+    ESP_LOGE(TAG, "Asset pack too small: %zu bytes", this->size_);
+    return false;
+  }
+  const auto *header = reinterpret_cast<const AssetPackHeader *>(this->base_);
+  if (header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION) {
+    ESP_LOGE(TAG, "Invalid asset pack header (magic 0x%08X, version %u)", (unsigned) header->magic,
+             header->version);
+    return false;
+  }
+  // La partition peut être plus grande que le pack : seule la taille déclarée compte
+  if (header->size > this->size_ ||
+      sizeof(AssetPackHeader) + header->count * sizeof(AssetPackEntry) > header->size) {
+    ESP_LOGE(TAG, "Asset pack truncated: %u bytes declared, %zu mapped", (unsigned) header->size, this->size_);
+    return false;
+  }
+  this->count_ = header->count;
+  for (uint16_t i = 0; i < this->count_; i++) {
+    const AssetPackEntry *entry = this->get_entry_(i);
+    // Somme sur 64 bits : un index forgé ne doit pas faire déborder la vérification
+    if (entry->offset % ASSET_PACK_ALIGNMENT != 0 || uint64_t(entry->offset) + entry->size > header->size) {
+      ESP_LOGE(TAG, "Asset pack entry %u out of bounds (offset %u, size %u)", i, (unsigned) entry->offset,
+               (unsigned) entry->size);
+      this->count_ = 0;
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifdef USE_ESP32
+bool AssetPack::map_() {
+  if (this->partition_label_ == nullptr) {
+    ESP_LOGE(TAG, "No partition label configured");
+    return false;
+  }
+  const esp_partition_t *partition =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, this->partition_label_);
+  if (partition == nullptr) {
+    ESP_LOGE(TAG, "Partition '%s' not found", this->partition_label_);
+    return false;
+  }
+  // Seule la taille déclarée par l'en-tête est projetée : la partition peut être
+  // bien plus grande que le pack, et l'espace d'adressage MMU est limité
+  AssetPackHeader header;
+  esp_err_t err = esp_partition_read(partition, 0, &header, sizeof(header));
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot read partition '%s': %s", this->partition_label_, esp_err_to_name(err));
+    return false;
+  }
+  if (header.magic != ASSET_PACK_MAGIC || header.size < sizeof(AssetPackHeader) || header.size > partition->size) {
+    ESP_LOGE(TAG, "Invalid asset pack in partition '%s' (magic 0x%08X, %u bytes declared, %u available)",
+             this->partition_label_, (unsigned) header.magic, (unsigned) header.size, (unsigned) partition->size);
+    return false;
+  }
+  const void *ptr = nullptr;
+  err = esp_partition_mmap(partition, 0, header.size, ESP_PARTITION_MMAP_DATA, &ptr, &this->mmap_handle_);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot map partition '%s': %s", this->partition_label_, esp_err_to_name(err));
+    return false;
+  }
+  this->base_ = static_cast<const uint8_t *>(ptr);
+  this->size_ = header.size;
+  return true;
+}
+#elif defined(USE_HOST)
+bool AssetPack::map_() {
+  if (this->file_path_ == nullptr) {
+    ESP_LOGE(TAG, "No asset pack file configured");
+    return false;
+  }
+  int fd = open(this->file_path_, O_RDONLY);
+  if (fd < 0) {
+    ESP_LOGE(TAG, "Cannot open %s (errno: %d - %s)", this->file_path_, errno, strerror(errno));
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ESP_LOGE(TAG, "Cannot stat %s", this->file_path_);
+    close(fd);
+    return false;
+  }
+  void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // Le mapping reste valide après fermeture du descripteur
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    ESP_LOGE(TAG, "Cannot map %s (errno: %d - %s)", this->file_path_, errno, strerror(errno));
+    return false;
+  }
+  this->base_ = static_cast<const uint8_t *>(ptr);
+  this->size_ = st.st_size;
+  return true;
+}
+#else
+bool AssetPack::map_() {
+  ESP_LOGE(TAG, "Asset packs are only supported on ESP32 and host platforms");
+  return false;
+}
+#endif
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "image.h"
+#include <vector>
+
+#ifdef USE_ESP32
+#include "esp_partition.h"
+#include "esp_idf_version.h"
+#endif
+
+namespace esphome {
+namespace image {
+
+// Pack d'images externe généré par le composant Python (little endian) :
+//   en-tête : magic "EIMG" | version u16 | nombre d'images u16 | taille totale u32
+//   index   : par image, offset u32 | taille u32 | largeur u16 | hauteur u16 | type u8 | transparence u8 | réservé u16
+//   données : pixels déjà au format cible, chaque image alignée sur ASSET_PACK_ALIGNMENT octets
+static const uint32_t ASSET_PACK_MAGIC = 0x474D4945;  // "EIMG"
+static const uint16_t ASSET_PACK_VERSION = 1;
+static const size_t ASSET_PACK_ALIGNMENT = 16;
+
+struct AssetPackHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;
+  uint32_t size;
+} __attribute__((packed));
+
+struct AssetPackEntry {
+  uint32_t offset;
+  uint32_t size;
+  uint16_t width;
+  uint16_t height;
+  uint8_t type;
+  uint8_t transparency;
+  uint16_t reserved;
+} __attribute__((packed));
+
+// Projette le pack en mémoire (partition data sur ESP32, fichier mmap sur host)
+// et fait pointer data_start_ des images enregistrées dedans, sans copie
+class AssetPack : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  // Avant les écrans, qui dessinent dès leur propre setup()
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+
+  void set_partition_label(const char *label) { this->partition_label_ = label; }
+  void set_file_path(const char *path) { this->file_path_ = path; }
+  void register_image(Image *image, uint16_t index) { this->images_.push_back({image, index}); }
+
+  // Pointeur vers les pixels de l'image d'index donné, nullptr si absent
+  const uint8_t *get_data(uint16_t index) const;
+  uint16_t get_count() const { return this->count_; }
+
+ protected:
+  struct Registration {
+    Image *image;
+    uint16_t index;
+  };
+
+  bool map_();
+  bool validate_();
+  const AssetPackEntry *get_entry_(uint16_t index) const;
+
+  const char *partition_label_{nullptr};
+  const char *file_path_{nullptr};
+  std::vector<Registration> images_;
+
+  const uint8_t *base_{nullptr};
+  size_t size_{0};
+  uint16_t count_{0};
+
+#ifdef USE_ESP32
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  esp_partition_mmap_handle_t mmap_handle_{};
+#else
+  spi_flash_mmap_handle_t mmap_handle_{};
+#endif
+#endif
+};
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+#include "image.h"
+#include <vector>
+
+namespace esphome {
+namespace image {
+
+// Lance le prefetch en tâche de fond et rend la main aussitôt ; loop() remet
+// les callbacks de chargement sur la boucle principale
+template<typename... Ts> class PrefetchAction : public Action<Ts...>, public Component {
+ public:
+  void set_images(std::vector<Image *> images) { this->images_ = std::move(images); }
+
+  void play(Ts... x) override { Image::prefetch_async(this->images_); }
+  void loop() override { Image::dispatch_prefetch_results(); }
+
+ protected:
+  std::vector<Image *> images_;
+};
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,142 @@
+#include "compositor.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+
+namespace esphome {
+namespace image {
+
+static const char *const TAG = "image.compositor";
+
+// Division par 255 arrondie, exacte pour v dans [0, 255 * 255]
+static inline uint8_t div255(uint32_t v) { return (v + 128 + ((v + 128) >> 8)) >> 8; }
+
+void Compositor::draw(display::Display *display, Color color_on, Color color_off) {
+  // Instantané de chaque couche pour toute la composition, chargement SD compris
+  this->snapshots_.clear();
+  for (auto &layer : this->layers_) {
+    Image *image = layer.image;
+    if (image == nullptr || layer.opacity == 0)
+      continue;
+    ImageBufferRef buffer = image->get_sd_buffer();
+    if (image->sd_runtime_ && buffer == nullptr && !image->sd_path_.empty()) {
+      if (!image->load_from_sd()) {
+        ESP_LOGE(TAG, "Failed to load SD image: %s", image->sd_path_.c_str());
+        continue;
+      }
+      buffer = image->get_sd_buffer();
+    }
+    if (buffer == nullptr && image->data_start_ == nullptr)
+      continue;
+    this->snapshots_.push_back({image, buffer, layer.x, layer.y, image->get_buffer_width_(buffer.get()),
+                                image->get_buffer_height_(buffer.get()), layer.opacity});
+  }
+  if (this->snapshots_.empty())
+    return;
+
+  // Rectangle englobant, restreint à la zone de clipping
+  int x0 = this->snapshots_[0].x;
+  int y0 = this->snapshots_[0].y;
+  int x1 = x0;
+  int y1 = y0;
+  for (auto &snap : this->snapshots_) {
+    x0 = std::min(x0, snap.x);
+    y0 = std::min(y0, snap.y);
+    x1 = std::max(x1, snap.x + snap.width);
+    y1 = std::max(y1, snap.y + snap.height);
+  }
+  auto clipping = display->get_clipping();
+  if (clipping.is_set()) {
+    x0 = std::max<int>(x0, clipping.x);
+    y0 = std::max<int>(y0, clipping.y);
+    x1 = std::min<int>(x1, clipping.x2());
+    y1 = std::min<int>(y1, clipping.y2());
+  }
+  if (x0 >= x1 || y0 >= y1)
+    return;
+
+  const int line_width = x1 - x0;
+  this->line_.resize(line_width);
+  this->base_layer_.resize(line_width);
+  this->row_.resize(line_width * 3);
+  const size_t layer_count = this->snapshots_.size();
+
+  for (int y = y0; y < y1; y++) {
+    std::fill(this->line_.begin(), this->line_.end(), Color(0, 0, 0, 0));
+    std::fill(this->base_layer_.begin(), this->base_layer_.end(), 0);
+
+    // Couche opaque la plus haute pour chaque pixel : tout ce qui est dessous est masqué
+    for (size_t i = 0; i < layer_count; i++) {
+      auto &snap = this->snapshots_[i];
+      int start, end;
+      if (snap.opacity != 255 || !snap.image->get_opaque_span_(snap.buffer, y - snap.y, start, end))
+        continue;
+      start = std::max(start + snap.x, x0) - x0;
+      end = std::min(end + snap.x, x1) - x0;
+      for (int x = start; x < end; x++)
+        this->base_layer_[x] = i;
+    }
+
+    // Opérateur "over" de bas en haut, en couleurs prémultipliées
+    for (size_t i = 0; i < layer_count; i++) {
+      auto &snap = this->snapshots_[i];
+      const int sy = y - snap.y;
+      if (sy < 0 || sy >= snap.height)
+        continue;
+      const ImageBuffer *pixels = snap.buffer.get();
+      const int start = std::max(snap.x, x0);
+      const int end = std::min(snap.x + snap.width, x1);
+      for (int x = start; x < end; x++) {
+        const int lx = x - x0;
+        if (this->base_layer_[lx] > i)
+          continue;
+        Color src = snap.image->get_layer_color_(pixels, x - snap.x, sy, color_on, color_off);
+        const uint8_t alpha = snap.opacity == 255 ? src.w : div255(src.w * snap.opacity);
+        if (alpha == 0)
+          continue;
+        Color &dst = this->line_[lx];
+        if (alpha == 255) {
+          dst = Color(src.r, src.g, src.b, 255);
+          continue;
+        }
+        const uint32_t inv = 255 - alpha;
+        dst = Color(div255(src.r * alpha + dst.r * inv), div255(src.g * alpha + dst.g * inv),
+                    div255(src.b * alpha + dst.b * inv), div255(255 * alpha + dst.w * inv));
+      }
+    }
+
+    // Émission unique de la ligne, même seuil de couverture que Image::draw : chaque
+    // plage couverte part en un seul draw_pixels_at, les trous ne sont pas écrits
+    int lx = 0;
+    while (lx < line_width) {
+      if (this->line_[lx].w < 0x80) {
+        lx++;
+        continue;
+      }
+      const int run_start = lx;
+      uint8_t *dst = this->row_.data();
+      for (; lx < line_width && this->line_[lx].w >= 0x80; lx++, dst += 3) {
+        const Color &c = this->line_[lx];
+        if (c.w == 255) {
+          dst[0] = c.r;
+          dst[1] = c.g;
+          dst[2] = c.b;
+          continue;
+        }
+        const uint32_t half = c.w / 2;
+        dst[0] = std::min<uint32_t>(255, (c.r * 255 + half) / c.w);
+        dst[1] = std::min<uint32_t>(255, (c.g * 255 + half) / c.w);
+        dst[2] = std::min<uint32_t>(255, (c.b * 255 + half) / c.w);
+      }
+      const uint8_t *row = this->row_.data();
+      if (lx - run_start == 1) {
+        display->draw_pixel_at(x0 + run_start, y, Color(row[0], row[1], row[2], 255));
+        continue;
+      }
+      display->draw_pixels_at(x0 + run_start, y, lx - run_start, 1, row, display::COLOR_ORDER_RGB,
+                              display::COLOR_BITNESS_888, true, 0, 0, 0);
+    }
+  }
+}
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "esphome/components/display/display.h"
+#include "image.h"
+#include <vector>
+
+namespace esphome {
+namespace image {
+
+struct CompositorLayer {
+  Image *image;
+  int x;
+  int y;
+  uint8_t opacity;
+};
+
+// Compose une pile d'images superposées ligne par ligne dans un tampon unique :
+// chaque pixel destination est écrit une seule fois, et les pixels recouverts par
+// une couche opaque supérieure ne sont jamais lus. Les couches sont dessinées dans
+// l'ordre d'ajout (la dernière au-dessus), sans l'orientation de dessin de Image::draw.
+class Compositor {
+ public:
+  void add_layer(Image *image, int x, int y, uint8_t opacity = 255) {
+    this->layers_.push_back({image, x, y, opacity});
+  }
+  void clear() { this->layers_.clear(); }
+  size_t size() const { return this->layers_.size(); }
+
+  void draw(display::Display *display, Color color_on = display::COLOR_ON, Color color_off = display::COLOR_OFF);
+
+ protected:
+  struct Snapshot {
+    Image *image;
+    ImageBufferRef buffer;
+    int x;
+    int y;
+    int width;
+    int height;
+    uint8_t opacity;
+  };
+
+  std::vector<CompositorLayer> layers_;
+  std::vector<Snapshot> snapshots_;
+  // Tampon de ligne en couleurs prémultipliées, et indice de la couche opaque la plus haute par pixel
+  std::vector<Color> line_;
+  std::vector<uint16_t> base_layer_;
+  // Plage de pixels couverts de la ligne, en RGB888 pour draw_pixels_at
+  std::vector<uint8_t> row_;
+};
+
+}  // namespace image
+}  // namespace esphome
@@ -1,13 +1,22 @@
 #include "image.h"
+#include "pixel_convert.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include <sys/stat.h>
 #include <stdio.h>
 #include <cmath>
+#include <cstring>
 #include "esp_task_wdt.h"
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #ifdef USE_ESP32
+#include "esp_pthread.h"
 #include <dirent.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -20,12 +29,165 @@ namespace image {
 
 static const char *const TAG = "image";
 
+// Prefetch : tampon stdio partagé par le lot et pile du thread de lecture
+static const size_t PREFETCH_IO_BUFFER_SIZE = 16 * 1024;
+static const uint32_t PREFETCH_READER_STACK_SIZE = 6 * 1024;
+// Pile de la tâche de fond de prefetch_async(), qui décode
+static const uint32_t PREFETCH_TASK_STACK_SIZE = 8 * 1024;
+
+// Nourrit le watchdog de tâche seulement si la tâche courante y est abonnée : les
+// threads de prefetch ne le sont pas, et IDF 5 journalise sinon "task not found"
+static void feed_task_watchdog() {
+#ifdef USE_ESP32
+  if (esp_task_wdt_status(nullptr) != ESP_OK)
+    return;
+#endif
+  esp_task_wdt_reset();
+}
+
+// Résultats de prefetch_async() en attente de remise sur la boucle principale
+static std::mutex prefetch_results_lock;
+static std::vector<std::pair<Image *, bool>> prefetch_results;
+static std::atomic<size_t> prefetch_results_count{0};
+
+// Crée un std::thread avec la pile demandée. Sur ESP32 la config pthread de la
+// tâche appelante est restaurée ensuite : les threads créés plus tard par
+// l'appelant gardent leur pile habituelle
+static std::thread start_thread([[maybe_unused]] uint32_t stack_size, std::function<void()> &&function) {
+#ifdef USE_ESP32
+  esp_pthread_cfg_t previous;
+  const bool had_cfg = esp_pthread_get_cfg(&previous) == ESP_OK;
+  esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+  cfg.stack_size = stack_size;
+  esp_pthread_set_cfg(&cfg);
+  std::thread thread(std::move(function));
+  if (had_cfg) {
+    esp_pthread_set_cfg(&previous);
+  } else {
+    esp_pthread_cfg_t defaults = esp_pthread_get_default_config();
+    esp_pthread_set_cfg(&defaults);
+  }
+  return thread;
+#else
+  return std::thread(std::move(function));
+#endif
+}
+
 // Lecteur de fichier SD global
 SDFileReader Image::global_sd_reader_ = nullptr;
 
+// Taille des tuiles (en pixels) pour les parcours orientés : une tuile source
+// de 16x16 tient dans quelques lignes de cache même en RGBA
+static const int ORIENTATION_TILE_SIZE = 16;
+
+// Transformation affine destination -> source pour une orientation donnée :
+// sx = x0 + dx * xx + dy * xy, sy = y0 + dx * yx + dy * yy
+struct OrientationMap {
+  int x0, xx, xy;
+  int y0, yx, yy;
+};
+
+static OrientationMap make_orientation_map(int width, int height, ImageRotation rotation, bool flip_x, bool flip_y) {
+  OrientationMap m{};
+  switch (rotation) {
+    case IMAGE_ROTATION_90:
+      m = {0, 0, 1, height - 1, -1, 0};
+      break;
+    case IMAGE_ROTATION_180:
+      m = {width - 1, -1, 0, height - 1, 0, -1};
+      break;
+    case IMAGE_ROTATION_270:
+      m = {width - 1, 0, -1, 0, 1, 0};
+      break;
+    default:
+      m = {0, 1, 0, 0, 0, 1};
+      break;
+  }
+  // Les miroirs s'appliquent dans l'espace source, avant la rotation
+  if (flip_x)
+    m = {width - 1 - m.x0, -m.xx, -m.xy, m.y0, m.yx, m.yy};
+  if (flip_y)
+    m = {m.x0, m.xx, m.xy, height - 1 - m.y0, -m.yx, -m.yy};
+  return m;
+}
+
+static bool is_rotation_swapped(ImageRotation rotation) {
+  return rotation == IMAGE_ROTATION_90 || rotation == IMAGE_ROTATION_270;
+}
+
+// Registre des buffers SD décodés partagés entre images. Les entrées ne gardent
+// qu'une référence faible : le buffer est libéré quand plus aucune image ne le publie
+enum SharedBufferClaim {
+  SHARED_BUFFER_READY,    // buffer déjà décodé, à publier tel quel
+  SHARED_BUFFER_CLAIMED,  // l'appelant doit décoder puis appeler shared_buffer_complete()
+  SHARED_BUFFER_BUSY,     // un autre appelant décode cette clé : shared_buffer_wait()
+};
+
+// Au-delà, l'image qui attend décode elle-même le fichier
+static const uint32_t SHARED_BUFFER_WAIT_TIMEOUT_MS = 10000;
+
+struct SharedBufferEntry {
+  std::weak_ptr<const ImageBuffer> buffer;
+  bool loading{false};
+};
+
+static std::mutex shared_buffers_lock;
+static std::condition_variable shared_buffers_cond;
+static std::map<SharedBufferKey, SharedBufferEntry> shared_buffers;
+
+// current : buffer déjà publié par l'appelant. S'il est celui du registre, c'est
+// un rechargement explicite et la clé est réservée pour relire le fichier
+static SharedBufferClaim shared_buffer_claim(const SharedBufferKey &key, const ImageBufferRef &current,
+                                             ImageBufferRef &buffer) {
+  std::lock_guard<std::mutex> guard(shared_buffers_lock);
+  auto &entry = shared_buffers[key];
+  buffer = entry.buffer.lock();
+  if (buffer != nullptr && buffer != current)
+    return SHARED_BUFFER_READY;
+  if (entry.loading)
+    return SHARED_BUFFER_BUSY;
+  entry.loading = true;
+  return SHARED_BUFFER_CLAIMED;
+}
+
+// buffer nul si le décodage a échoué : les images en attente échouent aussi
+static void shared_buffer_complete(const SharedBufferKey &key, const ImageBufferRef &buffer) {
+  {
+    std::lock_guard<std::mutex> guard(shared_buffers_lock);
+    auto &entry = shared_buffers[key];
+    entry.buffer = buffer;
+    entry.loading = false;
+  }
+  shared_buffers_cond.notify_all();
+}
+
+// Attente bornée : false si le chargement en cours n'a pas abouti à temps
+static bool shared_buffer_wait(const SharedBufferKey &key, ImageBufferRef &buffer) {
+  std::unique_lock<std::mutex> guard(shared_buffers_lock);
+  auto &entry = shared_buffers[key];
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHARED_BUFFER_WAIT_TIMEOUT_MS);
+  while (!shared_buffers_cond.wait_for(guard, std::chrono::milliseconds(100), [&]() { return !entry.loading; })) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return false;
+    feed_task_watchdog();
+  }
+  buffer = entry.buffer.lock();
+  return true;
+}
+
+SharedBufferKey Image::get_shared_buffer_key_() const {
+  return {this->sd_path_,     this->width_,       this->height_,    this->type_,
+          this->transparency_, this->sd_rotation_, this->sd_flip_x_, this->sd_flip_y_};
+}
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
+  this->draw(x, y, display, color_on, color_off, this->rotation_, this->flip_x_, this->flip_y_);
+}
+
+void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off, ImageRotation rotation,
+                 bool flip_x, bool flip_y) {
   // Charge l'image depuis la SD si nécessaire
-  if (sd_runtime_ && sd_buffer_.empty() && !sd_path_.empty()) {
+  if (sd_runtime_ && !this->has_sd_buffer() && !sd_path_.empty()) {
     ESP_LOGI(TAG, "Attempting to load SD image: %s", sd_path_.c_str());
     if (!load_from_sd()) {
       ESP_LOGE(TAG, "Failed to load SD image: %s", sd_path_.c_str());
@@ -37,13 +199,64 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
       }
       return;
     }
-    ESP_LOGI(TAG, "SD image loaded successfully, buffer size: %zu bytes", sd_buffer_.size());
+    ESP_LOGI(TAG, "SD image loaded successfully: %s", sd_path_.c_str());
+  }
+  // Buffer unique pour tout le dessin : un chargement concurrent publie un
+  // nouveau buffer sans invalider celui-ci
+  const SdPixels sd_pixels(this);
+  const ImageBuffer *pixels = sd_pixels.get();
+  // Image d'un pack pas encore projeté en mémoire : rien à dessiner
+  if (pixels == nullptr && this->data_start_ == nullptr)
+    return;
+  const int width = this->get_buffer_width_(pixels);
+  const int height = this->get_buffer_height_(pixels);
+
+  if (rotation != IMAGE_ROTATION_0 || flip_x || flip_y) {
+    // Parcours par tuiles dans l'espace destination : les lectures source
+    // restent localisées même quand une ligne destination est une colonne source
+    const bool swapped = is_rotation_swapped(rotation);
+    int dst_x0 = 0;
+    int dst_y0 = 0;
+    int dst_x1 = swapped ? height : width;
+    int dst_y1 = swapped ? width : height;
+
+    auto clipping = display->get_clipping();
+    if (clipping.is_set()) {
+      if (clipping.x > x)
+        dst_x0 += clipping.x - x;
+      if (clipping.y > y)
+        dst_y0 += clipping.y - y;
+      if (dst_x1 > clipping.x2() - x)
+        dst_x1 = clipping.x2() - x;
+      if (dst_y1 > clipping.y2() - y)
+        dst_y1 = clipping.y2() - y;
+    }
+
+    const OrientationMap m = make_orientation_map(width, height, rotation, flip_x, flip_y);
+    for (int tile_y = dst_y0; tile_y < dst_y1; tile_y += ORIENTATION_TILE_SIZE) {
+      const int tile_y1 = std::min(tile_y + ORIENTATION_TILE_SIZE, dst_y1);
+      for (int tile_x = dst_x0; tile_x < dst_x1; tile_x += ORIENTATION_TILE_SIZE) {
+        const int tile_x1 = std::min(tile_x + ORIENTATION_TILE_SIZE, dst_x1);
+        for (int dst_y = tile_y; dst_y < tile_y1; dst_y++) {
+          int src_x = m.x0 + tile_x * m.xx + dst_y * m.xy;
+          int src_y = m.y0 + tile_x * m.yx + dst_y * m.yy;
+          for (int dst_x = tile_x; dst_x < tile_x1; dst_x++) {
+            Color color;
+            if (this->get_draw_color_(pixels, src_x, src_y, color_on, color_off, color))
+              display->draw_pixel_at(x + dst_x, y + dst_y, color);
+            src_x += m.xx;
+            src_y += m.yx;
+          }
+        }
+      }
+    }
+    return;
   }
   
   int img_x0 = 0;
   int img_y0 = 0;
-  int w = width_;
-  int h = height_;
+  int w = width;
+  int h = height;
 
   auto clipping = display->get_clipping();
   if (clipping.is_set()) {
@@ -58,13 +271,13 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
   }
 
   ESP_LOGD(TAG, "Drawing image type %d, size %dx%d at (%d,%d), buffer empty: %s", 
-           type_, width_, height_, x, y, sd_buffer_.empty() ? "yes" : "no");
+           type_, width, height, x, y, pixels == nullptr ? "yes" : "no");
 
   switch (type_) {
     case IMAGE_TYPE_BINARY: {
       for (int img_x = img_x0; img_x < w; img_x++) {
         for (int img_y = img_y0; img_y < h; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
+          if (this->get_binary_pixel_(pixels, img_x, img_y)) {
             display->draw_pixel_at(x + img_x, y + img_y, color_on);
           } else if (!this->transparency_) {
             display->draw_pixel_at(x + img_x, y + img_y, color_off);
@@ -76,8 +289,8 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
     case IMAGE_TYPE_GRAYSCALE:
       for (int img_x = img_x0; img_x < w; img_x++) {
         for (int img_y = img_y0; img_y < h; img_y++) {
-          const uint32_t pos = (img_x + img_y * this->width_);
-          const uint8_t gray = this->get_data_byte_(pos);
+          const uint32_t pos = (img_x + img_y * width);
+          const uint8_t gray = this->get_data_byte_(pixels, pos);
           Color color = Color(gray, gray, gray, 0xFF);
           switch (this->transparency_) {
             case TRANSPARENCY_CHROMA_KEY:
@@ -102,7 +315,7 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
     case IMAGE_TYPE_RGB565:
       for (int img_x = img_x0; img_x < w; img_x++) {
         for (int img_y = img_y0; img_y < h; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
+          auto color = this->get_rgb565_pixel_(pixels, img_x, img_y);
           if (color.w >= 0x80) {
             display->draw_pixel_at(x + img_x, y + img_y, color);
           }
@@ -112,7 +325,7 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
     case IMAGE_TYPE_RGB:
       for (int img_x = img_x0; img_x < w; img_x++) {
         for (int img_y = img_y0; img_y < h; img_y++) {
-          auto color = this->get_rgb_pixel_(img_x, img_y);
+          auto color = this->get_rgb_pixel_(pixels, img_x, img_y);
           if (color.w >= 0x80) {
             display->draw_pixel_at(x + img_x, y + img_y, color);
           }
@@ -122,31 +335,162 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
   }
 }
 
+void Image::draw_region(int x, int y, display::Display *display, Color color_on, Color color_off, int src_x,
+                        int src_y, int width, int height) {
+  const SdPixels sd_pixels(this);
+  const ImageBuffer *pixels = sd_pixels.get();
+  if (pixels == nullptr && this->data_start_ == nullptr)
+    return;
+
+  // Région restreinte à l'image, puis à la zone de clipping (coordonnées source)
+  int x0 = std::max(src_x, 0);
+  int y0 = std::max(src_y, 0);
+  int x1 = std::min(src_x + width, this->get_buffer_width_(pixels));
+  int y1 = std::min(src_y + height, this->get_buffer_height_(pixels));
+  auto clipping = display->get_clipping();
+  if (clipping.is_set()) {
+    x0 = std::max(x0, clipping.x - x + src_x);
+    y0 = std::max(y0, clipping.y - y + src_y);
+    x1 = std::min(x1, clipping.x2() - x + src_x);
+    y1 = std::min(y1, clipping.y2() - y + src_y);
+  }
+
+  for (int img_y = y0; img_y < y1; img_y++) {
+    for (int img_x = x0; img_x < x1; img_x++) {
+      Color color;
+      if (this->get_draw_color_(pixels, img_x, img_y, color_on, color_off, color))
+        display->draw_pixel_at(x + img_x - src_x, y + img_y - src_y, color);
+    }
+  }
+}
+
 Color Image::get_pixel(int x, int y, const Color color_on, const Color color_off) const {
-  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
+  if (this->rotation_ == IMAGE_ROTATION_0 && !this->flip_x_ && !this->flip_y_)
+    return this->get_stored_pixel(x, y, color_on, color_off);
+  int width, height;
+  this->get_stored_size_(width, height);
+  const bool swapped = is_rotation_swapped(this->rotation_);
+  if (x < 0 || x >= (swapped ? height : width) || y < 0 || y >= (swapped ? width : height))
+    return color_off;
+  const OrientationMap m = make_orientation_map(width, height, this->rotation_, this->flip_x_, this->flip_y_);
+  return this->get_stored_pixel(m.x0 + x * m.xx + y * m.xy, m.y0 + x * m.yx + y * m.yy, color_on, color_off);
+}
+
+Color Image::get_stored_pixel(int x, int y, const Color color_on, const Color color_off) const {
+  const SdPixels sd_pixels(this);
+  const ImageBuffer *pixels = sd_pixels.get();
+  if (pixels == nullptr && this->data_start_ == nullptr)
+    return color_off;
+  if (x < 0 || x >= this->get_buffer_width_(pixels) || y < 0 || y >= this->get_buffer_height_(pixels))
     return color_off;
   switch (this->type_) {
     case IMAGE_TYPE_BINARY:
-      if (this->get_binary_pixel_(x, y))
+      if (this->get_binary_pixel_(pixels, x, y))
         return color_on;
       return color_off;
     case IMAGE_TYPE_GRAYSCALE:
-      return this->get_grayscale_pixel_(x, y);
+      return this->get_grayscale_pixel_(pixels, x, y);
     case IMAGE_TYPE_RGB565:
-      return this->get_rgb565_pixel_(x, y);
+      return this->get_rgb565_pixel_(pixels, x, y);
     case IMAGE_TYPE_RGB:
-      return this->get_rgb_pixel_(x, y);
+      return this->get_rgb_pixel_(pixels, x, y);
     default:
       return color_off;
   }
 }
 
-uint8_t Image::get_data_byte_(size_t pos) const {
-  if (!sd_buffer_.empty()) {
-    if (pos < sd_buffer_.size()) {
-      return sd_buffer_[pos];
+bool Image::get_draw_color_(const ImageBuffer *buffer, int x, int y, Color color_on, Color color_off,
+                            Color &color) const {
+  color = this->get_layer_color_(buffer, x, y, color_on, color_off);
+  return color.w >= 0x80;
+}
+
+Color Image::get_layer_color_(const ImageBuffer *buffer, int x, int y, Color color_on, Color color_off) const {
+  switch (this->type_) {
+    case IMAGE_TYPE_BINARY:
+      if (this->get_binary_pixel_(buffer, x, y))
+        return Color(color_on.r, color_on.g, color_on.b, 0xFF);
+      if (this->transparency_)
+        return Color(0, 0, 0, 0);
+      return Color(color_off.r, color_off.g, color_off.b, 0xFF);
+    case IMAGE_TYPE_GRAYSCALE: {
+      const uint8_t gray = this->get_data_byte_(buffer, x + y * this->get_buffer_width_(buffer));
+      switch (this->transparency_) {
+        case TRANSPARENCY_CHROMA_KEY:
+          if (gray == 1)
+            return Color(0, 0, 0, 0);
+          break;
+        case TRANSPARENCY_ALPHA_CHANNEL: {
+          auto on = (float) gray / 255.0f;
+          auto off = 1.0f - on;
+          return Color(color_on.r * on + color_off.r * off, color_on.g * on + color_off.g * off,
+                       color_on.b * on + color_off.b * off, 0xFF);
+        }
+        default:
+          break;
+      }
+      return Color(gray, gray, gray, 0xFF);
+    }
+    case IMAGE_TYPE_RGB565:
+      return this->get_rgb565_pixel_(buffer, x, y);
+    case IMAGE_TYPE_RGB:
+      return this->get_rgb_pixel_(buffer, x, y);
+  }
+  return Color(0, 0, 0, 0);
+}
+
+bool Image::get_opaque_span_(const ImageBufferRef &buffer, int row, int &start, int &end) {
+  const int width = this->get_buffer_width_(buffer.get());
+  const int height = this->get_buffer_height_(buffer.get());
+  if (row < 0 || row >= height)
+    return false;
+
+  // Sans transparence (ou alpha niveaux de gris, mélangé vers color_on/color_off) :
+  // toute la ligne est opaque, inutile de parcourir les pixels
+  if (this->transparency_ == TRANSPARENCY_OPAQUE ||
+      (this->type_ == IMAGE_TYPE_GRAYSCALE && this->transparency_ == TRANSPARENCY_ALPHA_CHANNEL)) {
+    start = 0;
+    end = width;
+    return true;
+  }
+
+  // Cache calculé une fois par source de pixels. Le buffer est identifié par son
+  // bloc de contrôle (référence faible) : il n'est pas retenu, et un buffer publié
+  // plus tard à la même adresse reste distingué
+  const void *source = buffer != nullptr ? static_cast<const void *>(buffer.get()) : this->data_start_;
+  const bool same_buffer =
+      !this->opaque_spans_buffer_.owner_before(buffer) && !buffer.owner_before(this->opaque_spans_buffer_);
+  if (this->opaque_spans_source_ != source || !same_buffer ||
+      this->opaque_spans_.size() != static_cast<size_t>(height)) {
+    this->opaque_spans_.assign(height, {0, 0});
+    for (int y = 0; y < height; y++) {
+      // Plus longue suite de pixels totalement opaques de la ligne
+      int run_start = 0;
+      for (int x = 0; x <= width; x++) {
+        const bool opaque = x < width && this->get_layer_color_(buffer.get(), x, y, display::COLOR_ON,
+                                                                display::COLOR_OFF).w == 0xFF;
+        if (opaque)
+          continue;
+        auto &span = this->opaque_spans_[y];
+        if (x - run_start > span.second - span.first)
+          span = {static_cast<uint16_t>(run_start), static_cast<uint16_t>(x)};
+        run_start = x + 1;
+      }
+    }
+    this->opaque_spans_source_ = source;
+    this->opaque_spans_buffer_ = buffer;
+  }
+  start = this->opaque_spans_[row].first;
+  end = this->opaque_spans_[row].second;
+  return end > start;
+}
+
+uint8_t Image::get_data_byte_(const ImageBuffer *buffer, size_t pos) const {
+  if (buffer != nullptr) {
+    if (pos < buffer->data.size()) {
+      return buffer->data[pos];
     }
-    ESP_LOGW(TAG, "Accessing SD buffer beyond bounds: %zu >= %zu", pos, sd_buffer_.size());
+    ESP_LOGW(TAG, "Accessing SD buffer beyond bounds: %zu >= %zu", pos, buffer->data.size());
     return 0;
   } else {
     return progmem_read_byte(this->data_start_ + pos);
@@ -159,10 +503,184 @@ bool Image::load_from_sd() {
     return false;
   }
 
-  ESP_LOGI(TAG, "Loading image from SD: %s", sd_path_.c_str());
-  
-  return decode_image_from_sd();
+  bool result;
+  if (!this->uses_shared_buffers_()) {
+    ESP_LOGI(TAG, "Loading image from SD: %s", sd_path_.c_str());
+    result = decode_image_from_sd();
+  } else {
+    const SharedBufferKey key = this->get_shared_buffer_key_();
+    ImageBufferRef buffer;
+    switch (shared_buffer_claim(key, this->get_sd_buffer(), buffer)) {
+      case SHARED_BUFFER_READY:
+        ESP_LOGD(TAG, "Sharing decoded SD image: %s", sd_path_.c_str());
+        this->publish_sd_buffer(std::move(buffer));
+        result = true;
+        break;
+      case SHARED_BUFFER_BUSY:
+        ESP_LOGD(TAG, "Waiting for concurrent load of SD image: %s", sd_path_.c_str());
+        result = this->adopt_shared_buffer_();
+        break;
+      default:
+        ESP_LOGI(TAG, "Loading image from SD: %s", sd_path_.c_str());
+        result = decode_image_from_sd();
+        shared_buffer_complete(key, result ? this->get_sd_buffer() : nullptr);
+        break;
+    }
+  }
+  this->load_callback_.call(result);
+  return result;
+}
+
+bool Image::adopt_shared_buffer_() {
+  ImageBufferRef buffer;
+  if (!shared_buffer_wait(this->get_shared_buffer_key_(), buffer)) {
+    ESP_LOGW(TAG, "Timed out waiting for concurrent load of %s, loading it directly", sd_path_.c_str());
+    return decode_image_from_sd();
+  }
+  if (buffer == nullptr)
+    return false;
+  this->publish_sd_buffer(std::move(buffer));
+  return true;
+}
+
+void Image::prefetch(const std::vector<Image *> &images) {
+  std::vector<std::pair<Image *, bool>> results;
+  prefetch_batch_(images, results);
+  // Callbacks après le lot : un callback qui recharge une autre image du lot
+  // ne tombe jamais sur une clé encore réservée par celui-ci
+  for (auto &result : results)
+    result.first->load_callback_.call(result.second);
+}
+
+void Image::prefetch_async(const std::vector<Image *> &images) {
+  start_thread(PREFETCH_TASK_STACK_SIZE, [images]() {
+    std::vector<std::pair<Image *, bool>> results;
+    prefetch_batch_(images, results);
+    std::lock_guard<std::mutex> guard(prefetch_results_lock);
+    prefetch_results.insert(prefetch_results.end(), results.begin(), results.end());
+    prefetch_results_count = prefetch_results.size();
+  }).detach();
 }
+
+void Image::dispatch_prefetch_results() {
+  if (prefetch_results_count == 0)
+    return;
+  std::vector<std::pair<Image *, bool>> results;
+  {
+    std::lock_guard<std::mutex> guard(prefetch_results_lock);
+    results.swap(prefetch_results);
+    prefetch_results_count = 0;
+  }
+  for (auto &result : results)
+    result.first->load_callback_.call(result.second);
+}
+
+void Image::prefetch_batch_(const std::vector<Image *> &images, std::vector<std::pair<Image *, bool>> &results) {
+  // Seules les images SD pas encore chargées sont lues, chacune une seule fois
+  std::vector<Image *> pending;
+  for (Image *image : images) {
+    if (image == nullptr || !image->sd_runtime_ || image->sd_path_.empty() || image->has_sd_buffer())
+      continue;
+    if (std::find(pending.begin(), pending.end(), image) == pending.end())
+      pending.push_back(image);
+  }
+  if (pending.empty())
+    return;
+
+  // La VFS FAT ne donne pas l'emplacement physique des fichiers : l'ordre des
+  // chemins regroupe les fichiers d'un même répertoire, dont les entrées
+  // restent ainsi dans le cache FAT d'une lecture à l'autre
+  std::stable_sort(pending.begin(), pending.end(), [](const Image *a, const Image *b) {
+    return a->sd_path_ < b->sd_path_;
+  });
+  ESP_LOGI(TAG, "Prefetching %zu SD images", pending.size());
+
+  // Pipeline à deux étages : un thread lit le fichier suivant pendant que
+  // l'appelant décode le courant. Deux emplacements de données suffisent.
+  // Chaque clé partagée est réservée juste avant sa lecture, jamais pour tout
+  // le lot : un chargement concurrent n'attend que l'image qui l'intéresse
+  struct Slot {
+    std::vector<uint8_t> data;
+    SharedBufferClaim claim{SHARED_BUFFER_CLAIMED};
+    ImageBufferRef buffer;
+    bool ok{false};
+  };
+  Slot slots[2];
+  std::mutex lock;
+  std::condition_variable cond;
+  size_t produced = 0;
+  size_t consumed = 0;
+
+  // fopen/fread sur FAT dépassent la pile pthread par défaut
+  std::thread reader = start_thread(PREFETCH_READER_STACK_SIZE, [&]() {
+    // Un seul tampon stdio partagé par toutes les lectures du lot
+    std::vector<char> io_buffer(PREFETCH_IO_BUFFER_SIZE);
+    for (size_t i = 0; i < pending.size(); i++) {
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [&]() { return i - consumed < 2; });
+      }
+      Image *image = pending[i];
+      Slot &slot = slots[i % 2];
+      slot.buffer = nullptr;
+      slot.claim = image->uses_shared_buffers_()
+                       ? shared_buffer_claim(image->get_shared_buffer_key_(), nullptr, slot.buffer)
+                       : SHARED_BUFFER_CLAIMED;
+      // Le slot a servi au fichier i - 2 : un lecteur qui ajoute au vecteur
+      // ne doit pas hériter de ses octets
+      slot.data.clear();
+      if (slot.claim == SHARED_BUFFER_CLAIMED)
+        slot.ok = image->read_sd_file(image->sd_path_, slot.data, io_buffer.data(), io_buffer.size());
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        produced = i + 1;
+      }
+      cond.notify_all();
+    }
+  });
+
+  // Images dont la clé est chargée ailleurs (plus haut dans le lot ou par un
+  // autre thread) : reprises en fin de lot
+  std::vector<Image *> waiting;
+  for (size_t i = 0; i < pending.size(); i++) {
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      while (!cond.wait_for(guard, std::chrono::milliseconds(100), [&]() { return produced > i; }))
+        feed_task_watchdog();
+    }
+    Image *image = pending[i];
+    Slot &slot = slots[i % 2];
+    switch (slot.claim) {
+      case SHARED_BUFFER_READY:
+        image->publish_sd_buffer(std::move(slot.buffer));
+        results.emplace_back(image, true);
+        break;
+      case SHARED_BUFFER_BUSY:
+        waiting.push_back(image);
+        break;
+      default: {
+        const bool result = slot.ok && image->decode_file_data_(slot.data);
+        if (!slot.ok)
+          ESP_LOGE(TAG, "Failed to read SD file: %s", image->sd_path_.c_str());
+        if (image->uses_shared_buffers_())
+          shared_buffer_complete(image->get_shared_buffer_key_(), result ? image->get_sd_buffer() : nullptr);
+        results.emplace_back(image, result);
+        break;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      consumed = i + 1;
+    }
+    cond.notify_all();
+  }
+  reader.join();
+
+  for (Image *image : waiting)
+    results.emplace_back(image, image->adopt_shared_buffer_());
+  ESP_LOGI(TAG, "Prefetch of %zu SD images completed (%zu shared)", pending.size(), waiting.size());
+}
+
 bool Image::decode_image_from_sd() {
     std::vector<uint8_t> file_data;
 
@@ -172,11 +690,24 @@ bool Image::decode_image_from_sd() {
         return false;
     }
 
+    return decode_file_data_(file_data);
+}
+
+bool Image::decode_file_data_(const std::vector<uint8_t> &file_data) {
+    // Le décodage se fait dans un buffer privé, publié uniquement une fois complet
+    auto buffer = std::make_shared<ImageBuffer>();
+    buffer->width = width_;
+    buffer->height = height_;
+
     // Détection simple du type d'image
     if (file_data.size() >= 2 && file_data[0] == 0xFF && file_data[1] == 0xD8) {
         // JPEG
         ESP_LOGI(TAG, "JPEG image detected");
-        return decode_jpeg_data(file_data);
+        if (!decode_jpeg_data(file_data, *buffer))
+            return false;
+        apply_sd_orientation_(*buffer);
+        publish_sd_buffer(std::move(buffer));
+        return true;
     }
     else if (file_data.size() >= 8 &&
              file_data[0] == 0x89 && file_data[1] == 0x50 &&
@@ -185,45 +716,50 @@ bool Image::decode_image_from_sd() {
              file_data[6] == 0x1A && file_data[7] == 0x0A) {
         // PNG
         ESP_LOGI(TAG, "PNG image detected");
-        return decode_png_data(file_data);
+        if (!decode_png_data(file_data, *buffer))
+            return false;
+        apply_sd_orientation_(*buffer);
+        publish_sd_buffer(std::move(buffer));
+        return true;
     }
 
     ESP_LOGE(TAG, "Unknown image format: %s", sd_path_.c_str());
     return false;
 }
 
-bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data) {
+// CORRECTION pour point de montage à la racine "/"
+std::string Image::map_sd_path_(const std::string &p) {
+  std::string result = p;
+  
+  // Si le chemin commence par "/sdcard/", remplacer par "/"
+  if (result.rfind("/sdcard/", 0) == 0) {
+    result = "/" + result.substr(8); // Enlever "/sdcard/" et garder juste "/"
+  }
+  
+  // Si le chemin ne commence pas par "/", l'ajouter
+  if (!result.empty() && result[0] != '/') {
+    result = "/" + result;
+  }
+  
+  // Nettoyer les doubles slashes
+  size_t pos = 0;
+  while ((pos = result.find("//", pos)) != std::string::npos) {
+    result.replace(pos, 2, "/");
+    pos += 1; // Éviter la boucle infinie
+  }
+  
+  ESP_LOGI(TAG, "Path mapping: '%s' -> '%s'", p.c_str(), result.c_str());
+  return result;
+}
+
+bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data, char *io_buffer,
+                         size_t io_buffer_size) {
   ESP_LOGI(TAG, "Attempting to read SD file: %s", path.c_str());
 
   // Utilise le lecteur spécifique à l'image ou le lecteur global
   SDFileReader reader = sd_file_reader_ ? sd_file_reader_ : global_sd_reader_;
 
-  // CORRECTION pour point de montage à la racine "/"
-  auto map_path = [](const std::string &p) -> std::string {
-    std::string result = p;
-    
-    // Si le chemin commence par "/sdcard/", remplacer par "/"
-    if (result.rfind("/sdcard/", 0) == 0) {
-      result = "/" + result.substr(8); // Enlever "/sdcard/" et garder juste "/"
-    }
-    
-    // Si le chemin ne commence pas par "/", l'ajouter
-    if (!result.empty() && result[0] != '/') {
-      result = "/" + result;
-    }
-    
-    // Nettoyer les doubles slashes
-    size_t pos = 0;
-    while ((pos = result.find("//", pos)) != std::string::npos) {
-      result.replace(pos, 2, "/");
-      pos += 1; // Éviter la boucle infinie
-    }
-    
-    ESP_LOGI(TAG, "Path mapping: '%s' -> '%s'", p.c_str(), result.c_str());
-    return result;
-  };
-
-  std::string fixed_path = map_path(path);
+  std::string fixed_path = map_sd_path_(path);
 
   if (!reader) {
     ESP_LOGE(TAG, "No SD file reader available - trying direct file access");
@@ -260,10 +796,13 @@ bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data) {
       return false;
     }
 
-    // Obtenir la taille du fichier
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    // Tampon stdio fourni par l'appelant (prefetch), réutilisé d'un fichier à l'autre
+    if (io_buffer != nullptr)
+      setvbuf(file, io_buffer, _IOFBF, io_buffer_size);
+
+    // Obtenir la taille du fichier sans aller-retour fseek/ftell
+    struct stat st;
+    long file_size = fstat(fileno(file), &st) == 0 ? (long) st.st_size : -1;
 
     if (file_size <= 0 || file_size > 50 * 1024 * 1024) {
       ESP_LOGE(TAG, "Invalid file size: %ld bytes", file_size);
@@ -273,17 +812,15 @@ bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data) {
 
     ESP_LOGI(TAG, "File size: %ld bytes", file_size);
 
-    // Lire le fichier par chunks
-    data.clear();
-    data.reserve(file_size);
+    // Lire le fichier par chunks, directement dans le buffer de destination
+    data.resize(file_size);
 
     constexpr size_t CHUNK_SIZE = 8192;
-    std::vector<uint8_t> chunk(CHUNK_SIZE);
     size_t total_read = 0;
 
     while (total_read < (size_t)file_size) {
       size_t to_read = std::min(CHUNK_SIZE, (size_t)file_size - total_read);
-      size_t bytes_read = fread(chunk.data(), 1, to_read, file);
+      size_t bytes_read = fread(data.data() + total_read, 1, to_read, file);
 
       if (bytes_read == 0) {
         if (ferror(file)) {
@@ -294,11 +831,10 @@ bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data) {
         break;
       }
 
-      data.insert(data.end(), chunk.begin(), chunk.begin() + bytes_read);
       total_read += bytes_read;
 
       if (total_read % (64 * 1024) == 0) {
-        esp_task_wdt_reset();
+        feed_task_watchdog();
       }
     }
 
@@ -306,6 +842,7 @@ bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data) {
 
     if (total_read != (size_t)file_size) {
       ESP_LOGW(TAG, "Read size mismatch: expected %ld, got %zu bytes", file_size, total_read);
+      data.resize(total_read);
     }
 
     ESP_LOGI(TAG, "SD file read successfully using direct access, size: %zu bytes", data.size());
@@ -323,11 +860,12 @@ bool Image::read_sd_file(const std::string &path, std::vector<uint8_t> &data) {
   return result;
 }
 
-bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
+bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data, ImageBuffer &buffer) {
   ESP_LOGI(TAG, "Decoding JPEG data (%zu bytes)", jpeg_data.size());
   
   size_t expected_size = get_expected_buffer_size();
-  sd_buffer_.resize(expected_size);
+  std::vector<uint8_t> &pixels = buffer.data;
+  pixels.resize(expected_size);
   
   ESP_LOGI(TAG, "Creating JPEG test pattern, expected size: %zu bytes, type: %d", expected_size, type_);
   
@@ -358,12 +896,12 @@ bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
               b = 80 + (int)(std::sin(x * 0.15f) + std::sin(y * 0.32f)) * 20;
             }
             
-            sd_buffer_[pos] = std::max(0, std::min(255, (int)r));     // R
-            sd_buffer_[pos + 1] = std::max(0, std::min(255, (int)g)); // G
-            sd_buffer_[pos + 2] = std::max(0, std::min(255, (int)b)); // B
+            pixels[pos] = std::max(0, std::min(255, (int)r));     // R
+            pixels[pos + 1] = std::max(0, std::min(255, (int)g)); // G
+            pixels[pos + 2] = std::max(0, std::min(255, (int)b)); // B
             
             if (transparency_ == TRANSPARENCY_ALPHA_CHANNEL && pos + 3 < expected_size) {
-              sd_buffer_[pos + 3] = 255; // Alpha opaque
+              pixels[pos + 3] = 255; // Alpha opaque
             }
           }
         }
@@ -394,11 +932,11 @@ bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
             uint16_t rgb565 = (r << 11) | (g << 5) | b;
             
             // Little endian
-            sd_buffer_[pos] = rgb565 & 0xFF;
-            sd_buffer_[pos + 1] = rgb565 >> 8;
+            pixels[pos] = rgb565 & 0xFF;
+            pixels[pos + 1] = rgb565 >> 8;
             
             if (transparency_ == TRANSPARENCY_ALPHA_CHANNEL && pos + 2 < expected_size) {
-              sd_buffer_[pos + 2] = 255; // Alpha opaque
+              pixels[pos + 2] = 255; // Alpha opaque
             }
           }
         }
@@ -413,7 +951,7 @@ bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
           if (pos < expected_size) {
             uint8_t base = (255 * y) / height_; // Dégradé vertical
             uint8_t noise = (int)(std::sin(x * 0.3f) * std::sin(y * 0.2f) * 30);
-            sd_buffer_[pos] = std::max(0, std::min(255, (int)(base + noise)));
+            pixels[pos] = std::max(0, std::min(255, (int)(base + noise)));
           }
         }
       }
@@ -421,7 +959,7 @@ bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
       
     case IMAGE_TYPE_BINARY:
       // Pattern de test binaire avec formes géométriques
-      std::fill(sd_buffer_.begin(), sd_buffer_.end(), 0);
+      std::fill(pixels.begin(), pixels.end(), 0);
       for (int y = 0; y < height_; y++) {
         for (int x = 0; x < width_; x++) {
           bool pixel_on = false;
@@ -439,7 +977,7 @@ bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
           if (pixel_on) {
             size_t pos = (y * ((width_ + 7) / 8)) + (x / 8);
             if (pos < expected_size) {
-              sd_buffer_[pos] |= (0x80 >> (x % 8));
+              pixels[pos] |= (0x80 >> (x % 8));
             }
           }
         }
@@ -448,19 +986,24 @@ bool Image::decode_jpeg_data(const std::vector<uint8_t> &jpeg_data) {
   }
   
   ESP_LOGI(TAG, "JPEG decode completed (test pattern generated), first few bytes: %02X %02X %02X %02X", 
-           sd_buffer_[0], sd_buffer_[1], sd_buffer_[2], sd_buffer_[3]);
+           pixels[0], pixels[1], pixels[2], pixels[3]);
   return true;
 }
 
-bool Image::decode_png_data(const std::vector<uint8_t> &png_data) {
+bool Image::decode_png_data(const std::vector<uint8_t> &png_data, ImageBuffer &buffer) {
   ESP_LOGI(TAG, "Decoding PNG data (%zu bytes)", png_data.size());
   
   size_t expected_size = get_expected_buffer_size();
-  sd_buffer_.resize(expected_size);
+  std::vector<uint8_t> &pixels = buffer.data;
+  pixels.resize(expected_size);
   
   ESP_LOGI(TAG, "Creating PNG test pattern, expected size: %zu bytes, type: %d", expected_size, type_);
   
-  // Créer un pattern de test différent pour PNG (arc-en-ciel)
+  // Créer un pattern de test différent pour PNG (arc-en-ciel), généré ligne par
+  // ligne en RGB888 puis converti vers le format cible
+  const bool alpha = transparency_ == TRANSPARENCY_ALPHA_CHANNEL;
+  std::vector<uint8_t> rgb_row(width_ * 3);
+  std::vector<uint8_t> luma_row(type_ == IMAGE_TYPE_BINARY ? width_ : 0);
   for (int y = 0; y < height_; y++) {
     for (int x = 0; x < width_; x++) {
       float hue = (float)(x + y) / (width_ + height_) * 6.0f; // 0 to 6
@@ -482,57 +1025,44 @@ bool Image::decode_png_data(const std::vector<uint8_t> &png_data) {
         case 5: r = 255; g = p; b = q; break;
         default: r = g = b = 0; break;
       }
-      
-      switch (type_) {
-        case IMAGE_TYPE_RGB: {
-          size_t pos = (y * width_ + x) * (transparency_ == TRANSPARENCY_ALPHA_CHANNEL ? 4 : 3);
-          if (pos + 2 < expected_size) {
-            sd_buffer_[pos] = r;
-            sd_buffer_[pos + 1] = g;
-            sd_buffer_[pos + 2] = b;
-            if (transparency_ == TRANSPARENCY_ALPHA_CHANNEL && pos + 3 < expected_size) {
-              sd_buffer_[pos + 3] = 255;
-            }
-          }
+      rgb_row[x * 3] = r;
+      rgb_row[x * 3 + 1] = g;
+      rgb_row[x * 3 + 2] = b;
+    }
+
+    switch (type_) {
+      case IMAGE_TYPE_RGB: {
+        uint8_t *dst = &pixels[y * width_ * (alpha ? 4 : 3)];
+        if (!alpha) {
+          memcpy(dst, rgb_row.data(), rgb_row.size());
           break;
         }
-        case IMAGE_TYPE_RGB565: {
-          size_t pos = (y * width_ + x) * (transparency_ == TRANSPARENCY_ALPHA_CHANNEL ? 3 : 2);
-          if (pos + 1 < expected_size) {
-            uint8_t r5 = r >> 3;
-            uint8_t g6 = g >> 2;
-            uint8_t b5 = b >> 3;
-            uint16_t rgb565 = (r5 << 11) | (g6 << 5) | b5;
-            
-            sd_buffer_[pos] = rgb565 & 0xFF;
-            sd_buffer_[pos + 1] = rgb565 >> 8;
-            
-            if (transparency_ == TRANSPARENCY_ALPHA_CHANNEL && pos + 2 < expected_size) {
-              sd_buffer_[pos + 2] = 255;
-            }
-          }
-          break;
+        for (int x = 0; x < width_; x++, dst += 4) {
+          memcpy(dst, &rgb_row[x * 3], 3);
+          dst[3] = 255;
         }
-        case IMAGE_TYPE_GRAYSCALE: {
-          size_t pos = y * width_ + x;
-          if (pos < expected_size) {
-            // Conversion RGB vers grayscale
-            sd_buffer_[pos] = (uint8_t)(0.299f * r + 0.587f * g + 0.114f * b);
-          }
+        break;
+      }
+      case IMAGE_TYPE_RGB565: {
+        uint8_t *dst = &pixels[y * width_ * (alpha ? 3 : 2)];
+        if (!alpha) {
+          rgb888_to_rgb565_row(rgb_row.data(), dst, width_, false);
           break;
         }
-        case IMAGE_TYPE_BINARY: {
-          size_t pos = (y * ((width_ + 7) / 8)) + (x / 8);
-          if (pos < expected_size) {
-            // Convertir en binaire basé sur la luminosité
-            uint8_t gray = (uint8_t)(0.299f * r + 0.587f * g + 0.114f * b);
-            if (gray > 128) {
-              sd_buffer_[pos] |= (0x80 >> (x % 8));
-            }
-          }
-          break;
+        for (int x = 0; x < width_; x++, dst += 3) {
+          rgb888_to_rgb565_row(&rgb_row[x * 3], dst, 1, false);
+          dst[2] = 255;
         }
+        break;
       }
+      case IMAGE_TYPE_GRAYSCALE:
+        rgb888_to_luma_row(rgb_row.data(), &pixels[y * width_], width_);
+        break;
+      case IMAGE_TYPE_BINARY:
+        // Convertir en binaire basé sur la luminosité
+        rgb888_to_luma_row(rgb_row.data(), luma_row.data(), width_);
+        luma_to_binary_row(luma_row.data(), &pixels[y * ((width_ + 7) / 8)], width_, 128);
+        break;
     }
   }
   
@@ -555,26 +1085,101 @@ size_t Image::get_expected_buffer_size() const {
   }
 }
 
+void Image::apply_sd_orientation_(ImageBuffer &buffer) {
+  if (sd_rotation_ == IMAGE_ROTATION_0 && !sd_flip_x_ && !sd_flip_y_)
+    return;
+
+  const int src_w = buffer.width;
+  const int src_h = buffer.height;
+  const std::vector<uint8_t> &src = buffer.data;
+  const bool swapped = is_rotation_swapped(sd_rotation_);
+  const int dst_w = swapped ? src_h : src_w;
+  const int dst_h = swapped ? src_w : src_h;
+  const OrientationMap m = make_orientation_map(src_w, src_h, sd_rotation_, sd_flip_x_, sd_flip_y_);
+
+  ESP_LOGD(TAG, "Applying SD orientation (rotation %d, flip x %d, flip y %d): %dx%d -> %dx%d", sd_rotation_,
+           sd_flip_x_, sd_flip_y_, src_w, src_h, dst_w, dst_h);
+
+  std::vector<uint8_t> rotated;
+  if (type_ == IMAGE_TYPE_BINARY) {
+    // 1 bpp : lignes alignées sur l'octet, bit de poids fort à gauche
+    const size_t src_stride = (src_w + 7) / 8;
+    const size_t dst_stride = (dst_w + 7) / 8;
+    rotated.assign(dst_stride * dst_h, 0);
+    for (int tile_y = 0; tile_y < dst_h; tile_y += ORIENTATION_TILE_SIZE) {
+      const int tile_y1 = std::min(tile_y + ORIENTATION_TILE_SIZE, dst_h);
+      for (int tile_x = 0; tile_x < dst_w; tile_x += ORIENTATION_TILE_SIZE) {
+        const int tile_x1 = std::min(tile_x + ORIENTATION_TILE_SIZE, dst_w);
+        for (int dst_y = tile_y; dst_y < tile_y1; dst_y++) {
+          int src_x = m.x0 + tile_x * m.xx + dst_y * m.xy;
+          int src_y = m.y0 + tile_x * m.yx + dst_y * m.yy;
+          uint8_t *dst_row = &rotated[dst_y * dst_stride];
+          for (int dst_x = tile_x; dst_x < tile_x1; dst_x++) {
+            if (src[src_y * src_stride + src_x / 8] & (0x80 >> (src_x % 8)))
+              dst_row[dst_x / 8] |= 0x80 >> (dst_x % 8);
+            src_x += m.xx;
+            src_y += m.yx;
+          }
+        }
+      }
+    }
+  } else {
+    const size_t pixel_size = bpp_ / 8;
+    rotated.resize(static_cast<size_t>(dst_w) * dst_h * pixel_size);
+    for (int tile_y = 0; tile_y < dst_h; tile_y += ORIENTATION_TILE_SIZE) {
+      const int tile_y1 = std::min(tile_y + ORIENTATION_TILE_SIZE, dst_h);
+      for (int tile_x = 0; tile_x < dst_w; tile_x += ORIENTATION_TILE_SIZE) {
+        const int tile_x1 = std::min(tile_x + ORIENTATION_TILE_SIZE, dst_w);
+        for (int dst_y = tile_y; dst_y < tile_y1; dst_y++) {
+          int src_x = m.x0 + tile_x * m.xx + dst_y * m.xy;
+          int src_y = m.y0 + tile_x * m.yx + dst_y * m.yy;
+          uint8_t *dst = &rotated[(static_cast<size_t>(dst_y) * dst_w + tile_x) * pixel_size];
+          for (int dst_x = tile_x; dst_x < tile_x1; dst_x++) {
+            memcpy(dst, &src[(static_cast<size_t>(src_y) * src_w + src_x) * pixel_size], pixel_size);
+            dst += pixel_size;
+            src_x += m.xx;
+            src_y += m.yx;
+          }
+        }
+      }
+    }
+  }
+
+  buffer.data.swap(rotated);
+  buffer.width = dst_w;
+  buffer.height = dst_h;
+}
+
 #ifdef USE_LVGL
 lv_img_dsc_t *Image::get_lv_img_dsc() {
+  ImageBufferRef buffer = this->get_sd_buffer();
+
   // Charge l'image SD si nécessaire
-  if (sd_runtime_ && sd_buffer_.empty() && !sd_path_.empty()) {
+  if (sd_runtime_ && buffer == nullptr && !sd_path_.empty()) {
     ESP_LOGD(TAG, "Loading SD image for LVGL: %s", sd_path_.c_str());
     if (!load_from_sd()) {
       ESP_LOGE(TAG, "Failed to load SD image for LVGL: %s", sd_path_.c_str());
       return nullptr;
     }
+    buffer = this->get_sd_buffer();
   }
   
-  const uint8_t *data_ptr = sd_buffer_.empty() ? this->data_start_ : sd_buffer_.data();
+  const uint8_t *data_ptr = buffer == nullptr ? this->data_start_ : buffer->data.data();
+  if (data_ptr == nullptr)
+    return nullptr;
   
   if (this->dsc_.data != data_ptr) {
+    // LVGL garde dsc_.data au-delà de cet appel : on conserve la référence
+    // jusqu'à ce qu'un nouveau buffer soit pris en compte
+    const int width = this->get_buffer_width_(buffer.get());
+    const int height = this->get_buffer_height_(buffer.get());
+    this->lv_buffer_ = buffer;
     this->dsc_.data = data_ptr;
     this->dsc_.header.always_zero = 0;
     this->dsc_.header.reserved = 0;
-    this->dsc_.header.w = this->width_;
-    this->dsc_.header.h = this->height_;
-    this->dsc_.data_size = this->get_width_stride() * this->get_height();
+    this->dsc_.header.w = width;
+    this->dsc_.header.h = height;
+    this->dsc_.data_size = ((width * this->get_bpp() + 7u) / 8u) * height;
     switch (this->get_type()) {
       case IMAGE_TYPE_BINARY:
         this->dsc_.header.cf = LV_IMG_CF_ALPHA_1BIT;
@@ -623,16 +1228,16 @@ lv_img_dsc_t *Image::get_lv_img_dsc() {
 }
 #endif
 
-bool Image::get_binary_pixel_(int x, int y) const {
-  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
+bool Image::get_binary_pixel_(const ImageBuffer *buffer, int x, int y) const {
+  const uint32_t width_8 = ((this->get_buffer_width_(buffer) + 7u) / 8u) * 8u;
   const uint32_t pos = x + y * width_8;
-  return this->get_data_byte_(pos / 8u) & (0x80 >> (pos % 8u));
+  return this->get_data_byte_(buffer, pos / 8u) & (0x80 >> (pos % 8u));
 }
 
-Color Image::get_rgb_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * this->bpp_ / 8;
-  Color color = Color(this->get_data_byte_(pos + 0), this->get_data_byte_(pos + 1),
-                      this->get_data_byte_(pos + 2), 0xFF);
+Color Image::get_rgb_pixel_(const ImageBuffer *buffer, int x, int y) const {
+  const uint32_t pos = (x + y * this->get_buffer_width_(buffer)) * this->bpp_ / 8;
+  Color color = Color(this->get_data_byte_(buffer, pos + 0), this->get_data_byte_(buffer, pos + 1),
+                      this->get_data_byte_(buffer, pos + 2), 0xFF);
 
   switch (this->transparency_) {
     case TRANSPARENCY_CHROMA_KEY:
@@ -641,7 +1246,7 @@ Color Image::get_rgb_pixel_(int x, int y) const {
       }
       break;
     case TRANSPARENCY_ALPHA_CHANNEL:
-      color.w = this->get_data_byte_(pos + 3);
+      color.w = this->get_data_byte_(buffer, pos + 3);
       break;
     default:
       break;
@@ -649,16 +1254,16 @@ Color Image::get_rgb_pixel_(int x, int y) const {
   return color;
 }
 
-Color Image::get_rgb565_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * this->bpp_ / 8;
-  uint16_t rgb565 = encode_uint16(this->get_data_byte_(pos), this->get_data_byte_(pos + 1));
+Color Image::get_rgb565_pixel_(const ImageBuffer *buffer, int x, int y) const {
+  const uint32_t pos = (x + y * this->get_buffer_width_(buffer)) * this->bpp_ / 8;
+  uint16_t rgb565 = encode_uint16(this->get_data_byte_(buffer, pos), this->get_data_byte_(buffer, pos + 1));
   auto r = (rgb565 & 0xF800) >> 11;
   auto g = (rgb565 & 0x07E0) >> 5;
   auto b = rgb565 & 0x001F;
   auto a = 0xFF;
   switch (this->transparency_) {
     case TRANSPARENCY_ALPHA_CHANNEL:
-      a = this->get_data_byte_(pos + 2);
+      a = this->get_data_byte_(buffer, pos + 2);
       break;
     case TRANSPARENCY_CHROMA_KEY:
       if (rgb565 == 0x0020)
@@ -667,12 +1272,12 @@ Color Image::get_rgb565_pixel_(int x, int y) const {
     default:
       break;
   }
-  return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), a);
+  return Color(expand_5bit(r), expand_6bit(g), expand_5bit(b), a);
 }
 
-Color Image::get_grayscale_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_);
-  const uint8_t gray = this->get_data_byte_(pos);
+Color Image::get_grayscale_pixel_(const ImageBuffer *buffer, int x, int y) const {
+  const uint32_t pos = (x + y * this->get_buffer_width_(buffer));
+  const uint8_t gray = this->get_data_byte_(buffer, pos);
   switch (this->transparency_) {
     case TRANSPARENCY_CHROMA_KEY:
       if (gray == 1)
@@ -685,8 +1290,59 @@ Color Image::get_grayscale_pixel_(int x, int y) const {
   }
 }
 
-int Image::get_width() const { return this->width_; }
-int Image::get_height() const { return this->height_; }
+// Un buffer SD publié peut avoir des dimensions différentes (orientation au décodage)
+// Encombrement du dessin par défaut : largeur et hauteur échangées à 90/270
+int Image::get_width() const {
+  int width, height;
+  this->get_stored_size_(width, height);
+  return is_rotation_swapped(this->rotation_) ? height : width;
+}
+int Image::get_height() const {
+  int width, height;
+  this->get_stored_size_(width, height);
+  return is_rotation_swapped(this->rotation_) ? width : height;
+}
+
+void Image::get_stored_size_(int &width, int &height) const {
+  const uint32_t size = this->sd_size_.load(std::memory_order_relaxed);
+  width = size != 0 ? static_cast<int>(size >> 16) : this->width_;
+  height = size != 0 ? static_cast<int>(size & 0xFFFF) : this->height_;
+}
+
+// Les lecteurs (SdPixels) ne doivent jamais prendre de verrou
+static_assert(std::atomic<const ImageBuffer *>::is_always_lock_free, "SD pixel pointer must be lock-free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "SD reader count must be lock-free");
+
+ImageBufferRef Image::get_sd_buffer() const {
+  std::lock_guard<std::mutex> guard(this->sd_lock_);
+  return this->sd_buffer_;
+}
+
+void Image::publish_sd_buffer(ImageBufferRef buffer) {
+  std::lock_guard<std::mutex> guard(this->sd_lock_);
+  const ImageBuffer *pixels = buffer.get();
+  this->sd_size_.store(pixels != nullptr ? static_cast<uint32_t>(pixels->width) << 16 | (pixels->height & 0xFFFF) : 0,
+                       std::memory_order_relaxed);
+  this->sd_pixels_.store(pixels);
+  // L'ancien buffer a pu être vu par un lecteur encore actif : mis de côté
+  if (this->sd_buffer_ != nullptr)
+    this->sd_retired_.push_back(std::move(this->sd_buffer_));
+  this->sd_buffer_ = std::move(buffer);
+  this->sd_retired_pending_ = !this->sd_retired_.empty();
+  if (this->sd_readers_.load() == 0) {
+    this->sd_retired_.clear();
+    this->sd_retired_pending_ = false;
+  }
+}
+
+void Image::reclaim_sd_buffers_() const {
+  // Si un écrivain tient le verrou, la libération attend le lecteur ou la publication suivante
+  std::unique_lock<std::mutex> guard(this->sd_lock_, std::try_to_lock);
+  if (!guard.owns_lock() || this->sd_readers_.load() != 0)
+    return;
+  this->sd_retired_.clear();
+  this->sd_retired_pending_ = false;
+}
 ImageType Image::get_type() const { return this->type_; }
 
 Image::Image(const uint8_t *data_start, int width, int height, ImageType type, Transparency transparency)
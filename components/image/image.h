@@ -8,6 +8,10 @@
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 #ifdef USE_ESP32
 #include "esp_vfs_fat.h"
@@ -31,6 +35,9 @@ class SdMmcCardComponent;
 namespace esphome {
 namespace image {
 
+class AssetPack;
+class Compositor;
+
 enum ImageType {
   IMAGE_TYPE_BINARY = 0,
   IMAGE_TYPE_GRAYSCALE = 1,
@@ -44,24 +51,91 @@ enum Transparency {
   TRANSPARENCY_ALPHA_CHANNEL = 2,
 };
 
+// Rotation horaire appliquée après les éventuels miroirs X/Y
+enum ImageRotation {
+  IMAGE_ROTATION_0 = 0,
+  IMAGE_ROTATION_90 = 1,
+  IMAGE_ROTATION_180 = 2,
+  IMAGE_ROTATION_270 = 3,
+};
+
+// Pixels décodés d'une image SD. Immuable une fois publié : un nouveau
+// chargement publie un nouveau buffer au lieu de modifier celui-ci (RCU)
+struct ImageBuffer {
+  std::vector<uint8_t> data;
+  int width{0};
+  int height{0};
+};
+using ImageBufferRef = std::shared_ptr<const ImageBuffer>;
+
+// Clé du registre des buffers SD partagés : deux images de même clé décodent
+// exactement les mêmes pixels et peuvent donc partager un seul buffer
+struct SharedBufferKey {
+  std::string path;
+  int width;
+  int height;
+  ImageType type;
+  Transparency transparency;
+  ImageRotation rotation;
+  bool flip_x;
+  bool flip_y;
+
+  bool operator<(const SharedBufferKey &other) const {
+    return std::tie(path, width, height, type, transparency, rotation, flip_x, flip_y) <
+           std::tie(other.path, other.width, other.height, other.type, other.transparency, other.rotation,
+                    other.flip_x, other.flip_y);
+  }
+};
+
 // Type pour la fonction de lecture de fichier SD
 using SDFileReader = std::function<bool(const std::string&, std::vector<uint8_t>&)>;
 
 class Image : public display::BaseImage {
+  friend class AssetPack;
+  friend class Compositor;
+
  public:
   Image(const uint8_t *data_start, int width, int height, ImageType type, Transparency transparency);
   
+  // Pixel en coordonnées orientées (orientation par défaut), cohérent avec get_width()/get_height()
   Color get_pixel(int x, int y, Color color_on = display::COLOR_ON, Color color_off = display::COLOR_OFF) const;
+  // Pixel en coordonnées des pixels stockés, sans l'orientation par défaut
+  Color get_stored_pixel(int x, int y, Color color_on = display::COLOR_ON,
+                         Color color_off = display::COLOR_OFF) const;
   
   int get_width() const override;
   int get_height() const override;
   const uint8_t *get_data_start() const { return this->data_start_; }
+  // Rattache l'image à des pixels externes (pack d'images projeté en mémoire)
+  void set_data_start(const uint8_t *data_start) { this->data_start_ = data_start; }
   ImageType get_type() const;
   int get_bpp() const { return this->bpp_; }
   
-  size_t get_width_stride() const { return (this->width_ * this->get_bpp() + 7u) / 8u; }
+  // Octets par ligne des pixels stockés (indépendant de l'orientation de dessin)
+  size_t get_width_stride() const {
+    int width, height;
+    this->get_stored_size_(width, height);
+    return (width * this->get_bpp() + 7u) / 8u;
+  }
   
   void draw(int x, int y, display::Display *display, Color color_on, Color color_off) override;
+  // Dessin orienté : miroirs appliqués d'abord, puis rotation horaire
+  void draw(int x, int y, display::Display *display, Color color_on, Color color_off, ImageRotation rotation,
+            bool flip_x = false, bool flip_y = false);
+  // Dessine seulement le sous-rectangle (src_x, src_y, width, height) de l'image en (x, y),
+  // ligne par ligne : utilisé par ImageView pour les icônes d'un atlas
+  void draw_region(int x, int y, display::Display *display, Color color_on, Color color_off, int src_x, int src_y,
+                   int width, int height);
+  
+  // Orientation par défaut utilisée par draw() sans paramètres d'orientation.
+  // get_width()/get_height() et get_pixel() la suivent (encombrement échangé à
+  // 90/270) ; get_width_stride() et le descripteur LVGL restent ceux des pixels
+  // stockés, non orientés (utiliser set_sd_orientation() pour orienter les pixels)
+  void set_orientation(ImageRotation rotation, bool flip_x = false, bool flip_y = false) {
+    this->rotation_ = rotation;
+    this->flip_x_ = flip_x;
+    this->flip_y_ = flip_y;
+  }
   
   bool has_transparency() const { return this->transparency_ != TRANSPARENCY_OPAQUE; }
   
@@ -69,10 +143,43 @@ class Image : public display::BaseImage {
   void set_sd_path(const std::string &path) { this->sd_path_ = path; }
   void set_sd_runtime(bool enabled) { this->sd_runtime_ = enabled; }
   void set_sd_file_reader(SDFileReader reader) { this->sd_file_reader_ = reader; }
+  // Orientation appliquée une seule fois au décodage (largeur/hauteur échangées pour 90/270)
+  void set_sd_orientation(ImageRotation rotation, bool flip_x = false, bool flip_y = false) {
+    this->sd_rotation_ = rotation;
+    this->sd_flip_x_ = flip_x;
+    this->sd_flip_y_ = flip_y;
+  }
+  // Charge l'image depuis la SD. Les images de même chemin, taille, type, transparence
+  // et orientation partagent un seul buffer décodé ; un chargement déjà en cours pour
+  // la même clé (autre thread) est attendu au lieu d'être refait. Les images avec
+  // leur propre lecteur (set_sd_file_reader) ne partagent pas
   bool load_from_sd();
+  
+  // Référence propriétaire au buffer SD courant (nullptr si non chargé), pour le
+  // garder au-delà d'un dessin (LVGL, compositeur, registre partagé). Prend le
+  // verrou des écrivains ; les lectures de pixels passent par SdPixels, sans verrou
+  ImageBufferRef get_sd_buffer() const;
+  // Publie un nouveau buffer. Les lecteurs en cours gardent l'ancien, libéré dès
+  // qu'aucun SdPixels ne peut plus le voir
+  void publish_sd_buffer(ImageBufferRef buffer);
+  bool has_sd_buffer() const { return this->sd_pixels_.load() != nullptr; }
 
   bool mount_sd_card(); 
 
+  // Charge un lot d'images SD (typiquement une page d'interface) en une passe :
+  // lectures triées par chemin avec un seul tampon d'E/S, lecture du fichier
+  // suivant pendant le décodage du courant. Bloquant jusqu'à la fin du lot ;
+  // les callbacks de chargement sont appelés une fois le lot terminé
+  static void prefetch(const std::vector<Image *> &images);
+  // Même lot exécuté dans une tâche de fond : retourne immédiatement. Les buffers
+  // sont publiés dès qu'ils sont décodés ; les callbacks de chargement sont remis
+  // sur la boucle principale par dispatch_prefetch_results()
+  static void prefetch_async(const std::vector<Image *> &images);
+  // À appeler depuis la boucle principale (PrefetchAction::loop)
+  static void dispatch_prefetch_results();
+  // Appelé après chaque chargement SD (paresseux ou prefetch) avec le résultat
+  void add_on_load_callback(std::function<void(bool)> &&callback) { this->load_callback_.add(std::move(callback)); }
+
   
   
   // Fonction statique pour enregistrer un lecteur de fichier global
@@ -83,19 +190,67 @@ class Image : public display::BaseImage {
 #endif
 
  protected:
-  bool get_binary_pixel_(int x, int y) const;
-  Color get_rgb_pixel_(int x, int y) const;
-  Color get_rgb565_pixel_(int x, int y) const;
-  Color get_grayscale_pixel_(int x, int y) const;
+  // Pixels SD visibles pendant la durée de vie de l'objet (un dessin), sans verrou :
+  // compteur de lecteurs puis chargement du pointeur brut publié. Un buffer remplacé
+  // n'est libéré qu'une fois le compteur retombé à zéro ; un lecteur arrivé après
+  // le remplacement ne peut plus le voir
+  class SdPixels {
+   public:
+    explicit SdPixels(const Image *image) : image_(image) {
+      image->sd_readers_.fetch_add(1);
+      this->pixels_ = image->sd_pixels_.load();
+    }
+    ~SdPixels() {
+      if (this->image_->sd_readers_.fetch_sub(1) == 1 && this->image_->sd_retired_pending_.load())
+        this->image_->reclaim_sd_buffers_();
+    }
+    SdPixels(const SdPixels &) = delete;
+    SdPixels &operator=(const SdPixels &) = delete;
+    const ImageBuffer *get() const { return this->pixels_; }
+
+   protected:
+    const Image *image_;
+    const ImageBuffer *pixels_;
+  };
+  // Libère les buffers remplacés si aucun lecteur n'est actif ; n'attend jamais le verrou
+  void reclaim_sd_buffers_() const;
+  // Dimensions des pixels stockés : buffer SD publié, sinon données PROGMEM
+  void get_stored_size_(int &width, int &height) const;
+
+  // Accès pixels sur un instantané : buffer SD si non nul, sinon données PROGMEM
+  bool get_binary_pixel_(const ImageBuffer *buffer, int x, int y) const;
+  Color get_rgb_pixel_(const ImageBuffer *buffer, int x, int y) const;
+  Color get_rgb565_pixel_(const ImageBuffer *buffer, int x, int y) const;
+  Color get_grayscale_pixel_(const ImageBuffer *buffer, int x, int y) const;
+  // Couleur à dessiner pour un pixel source, false si le pixel est transparent
+  bool get_draw_color_(const ImageBuffer *buffer, int x, int y, Color color_on, Color color_off, Color &color) const;
+  // Couleur d'un pixel avec son alpha réel (0 = transparent, 0xFF = opaque)
+  Color get_layer_color_(const ImageBuffer *buffer, int x, int y, Color color_on, Color color_off) const;
+  // Plus longue suite [start, end) de pixels totalement opaques de la ligne row ; false si aucune
+  bool get_opaque_span_(const ImageBufferRef &buffer, int row, int &start, int &end);
   
-  uint8_t get_data_byte_(size_t pos) const;
+  uint8_t get_data_byte_(const ImageBuffer *buffer, size_t pos) const;
+  int get_buffer_width_(const ImageBuffer *buffer) const { return buffer != nullptr ? buffer->width : this->width_; }
+  int get_buffer_height_(const ImageBuffer *buffer) const { return buffer != nullptr ? buffer->height : this->height_; }
   
   // Méthodes privées pour le décodage d'images
   bool decode_image_from_sd();
-  bool decode_jpeg_data(const std::vector<uint8_t> &jpeg_data);
-  bool decode_png_data(const std::vector<uint8_t> &png_data);
-  bool read_sd_file(const std::string &path, std::vector<uint8_t> &data);
+  bool decode_file_data_(const std::vector<uint8_t> &file_data);
+  static std::string map_sd_path_(const std::string &path);
+  // Exécute le lot de prefetch sans appeler les callbacks ; un résultat par image traitée
+  static void prefetch_batch_(const std::vector<Image *> &images, std::vector<std::pair<Image *, bool>> &results);
+  SharedBufferKey get_shared_buffer_key_() const;
+  // Un lecteur propre à l'image (autre carte ou montage) n'entre pas dans la
+  // clé : ces images ne partagent pas leurs pixels
+  bool uses_shared_buffers_() const { return !this->sd_file_reader_; }
+  // Attend le chargement en cours de la clé de l'image et publie son buffer
+  bool adopt_shared_buffer_();
+  bool decode_jpeg_data(const std::vector<uint8_t> &jpeg_data, ImageBuffer &buffer);
+  bool decode_png_data(const std::vector<uint8_t> &png_data, ImageBuffer &buffer);
+  bool read_sd_file(const std::string &path, std::vector<uint8_t> &data, char *io_buffer = nullptr,
+                    size_t io_buffer_size = 0);
   size_t get_expected_buffer_size() const;
+  void apply_sd_orientation_(ImageBuffer &buffer);
 
   bool sdcard_mounted_ = false; 
   
@@ -106,12 +261,33 @@ class Image : public display::BaseImage {
   const uint8_t *data_start_;
   Transparency transparency_;
   size_t bpp_{};
+  ImageRotation rotation_{IMAGE_ROTATION_0};
+  bool flip_x_{false};
+  bool flip_y_{false};
+
+  // Cache des plages opaques par ligne, valide pour une source de pixels donnée
+  std::vector<std::pair<uint16_t, uint16_t>> opaque_spans_;
+  const void *opaque_spans_source_{nullptr};
+  std::weak_ptr<const ImageBuffer> opaque_spans_buffer_;
   
   // Support SD
   std::string sd_path_{};
   bool sd_runtime_{false};
-  std::vector<uint8_t> sd_buffer_;
+  // Buffer SD courant. sd_buffer_ et sd_retired_ sont protégés par sd_lock_
+  // (écrivains seulement) ; les lecteurs n'utilisent que les atomiques
+  mutable std::mutex sd_lock_;
+  ImageBufferRef sd_buffer_;
+  mutable std::vector<ImageBufferRef> sd_retired_;
+  std::atomic<const ImageBuffer *> sd_pixels_{nullptr};
+  // Largeur << 16 | hauteur du buffer publié, 0 sans buffer
+  std::atomic<uint32_t> sd_size_{0};
+  mutable std::atomic<uint32_t> sd_readers_{0};
+  mutable std::atomic<bool> sd_retired_pending_{false};
   SDFileReader sd_file_reader_;
+  CallbackManager<void(bool)> load_callback_;
+  ImageRotation sd_rotation_{IMAGE_ROTATION_0};
+  bool sd_flip_x_{false};
+  bool sd_flip_y_{false};
   
   // Lecteur de fichier global (partagé par toutes les images)
   static SDFileReader global_sd_reader_;
@@ -119,6 +295,8 @@ class Image : public display::BaseImage {
 
 #ifdef USE_LVGL
   lv_img_dsc_t dsc_{};
+  // Maintient en vie le buffer référencé par dsc_.data tant que LVGL l'utilise
+  ImageBufferRef lv_buffer_;
 #endif
 };
 
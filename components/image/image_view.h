@@ -0,0 +1,47 @@
+#pragma once
+
+#include "esphome/components/display/display.h"
+#include "image.h"
+
+namespace esphome {
+namespace image {
+
+// Icône d'un atlas : simple référence à un sous-rectangle d'une image partagée,
+// sans données propres. Le dessin ne parcourt que ce sous-rectangle
+class ImageView : public display::BaseImage {
+ public:
+  ImageView() = default;
+  ImageView(Image *atlas, int x, int y, int width, int height) { this->set_region(atlas, x, y, width, height); }
+
+  void set_region(Image *atlas, int x, int y, int width, int height) {
+    this->atlas_ = atlas;
+    this->x_ = x;
+    this->y_ = y;
+    this->width_ = width;
+    this->height_ = height;
+  }
+
+  void draw(int x, int y, display::Display *display, Color color_on, Color color_off) override {
+    if (this->atlas_ != nullptr)
+      this->atlas_->draw_region(x, y, display, color_on, color_off, this->x_, this->y_, this->width_, this->height_);
+  }
+  int get_width() const override { return this->width_; }
+  int get_height() const override { return this->height_; }
+
+  Image *get_atlas() const { return this->atlas_; }
+  Color get_pixel(int x, int y, Color color_on = display::COLOR_ON, Color color_off = display::COLOR_OFF) const {
+    if (this->atlas_ == nullptr || x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
+      return color_off;
+    return this->atlas_->get_stored_pixel(this->x_ + x, this->y_ + y, color_on, color_off);
+  }
+
+ protected:
+  Image *atlas_{nullptr};
+  int x_{0};
+  int y_{0};
+  int width_{0};
+  int height_{0};
+};
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,491 @@
+#include "pixel_convert.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace esphome {
+namespace image {
+
+// Coefficients YCbCr -> RGB (JFIF) en virgule fixe Q14 : tiennent sur 16 bits signés,
+// ce qui permet le même calcul entier en scalaire et avec _mm_madd_epi16
+static const int YCC_SHIFT = 14;
+static const int YCC_ROUND = 1 << (YCC_SHIFT - 1);
+static const int16_t YCC_CR_R = 22970;   // 1.402
+static const int16_t YCC_CB_G = -5638;   // -0.344136
+static const int16_t YCC_CR_G = -11700;  // -0.714136
+static const int16_t YCC_CB_B = 29032;   // 1.772
+
+// Matrice de Bayer 4x4 ramenée sur 0..255 (seuils 8, 24, ..., 248)
+static const uint8_t BAYER_4X4[4][4] = {
+    {8, 136, 40, 168},
+    {200, 72, 232, 104},
+    {56, 184, 24, 152},
+    {248, 120, 216, 88},
+};
+
+static inline uint8_t clamp_u8(int value) { return value < 0 ? 0 : (value > 255 ? 255 : value); }
+
+static inline void store_rgb565(uint8_t *dst, uint16_t value, bool big_endian) {
+  if (big_endian) {
+    dst[0] = value >> 8;
+    dst[1] = value & 0xFF;
+  } else {
+    dst[0] = value & 0xFF;
+    dst[1] = value >> 8;
+  }
+}
+
+static inline void ycbcr_pixel(uint8_t y, uint8_t cb, uint8_t cr, uint8_t &r, uint8_t &g, uint8_t &b) {
+  const int db = cb - 128;
+  const int dr = cr - 128;
+  r = clamp_u8(y + ((YCC_CR_R * dr + YCC_ROUND) >> YCC_SHIFT));
+  g = clamp_u8(y + ((YCC_CB_G * db + YCC_CR_G * dr + YCC_ROUND) >> YCC_SHIFT));
+  b = clamp_u8(y + ((YCC_CB_B * db + YCC_ROUND) >> YCC_SHIFT));
+}
+
+// movemask donne le premier pixel dans le bit 0, le format 1 bpp le veut dans le bit 7
+static inline uint8_t reverse_bits(uint8_t value) {
+  value = (value & 0xF0) >> 4 | (value & 0x0F) << 4;
+  value = (value & 0xCC) >> 2 | (value & 0x33) << 2;
+  value = (value & 0xAA) >> 1 | (value & 0x55) << 1;
+  return value;
+}
+
+#if defined(__SSE2__)
+// Coefficients (Cb, Cr) entrelacés pour _mm_madd_epi16
+static inline __m128i ycc_coef_pair(int16_t cb_coef, int16_t cr_coef) {
+  return _mm_set1_epi32(static_cast<uint16_t>(cb_coef) | static_cast<uint32_t>(static_cast<uint16_t>(cr_coef)) << 16);
+}
+
+// 4 pixels RGB888 en mots de 32 bits r | g << 8 | b << 16 (octet haut indéterminé).
+// Lit un octet après le 4e pixel : l'appelant garantit qu'un pixel suit
+static inline __m128i load_rgb888_x4(const uint8_t *src) {
+  uint32_t lanes[4];
+  for (int k = 0; k < 4; k++)
+    memcpy(&lanes[k], src + k * 3, 4);
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes));
+}
+
+// Mots r | g << 8 | b << 16 -> RGB565 dans les 16 bits bas de chaque mot
+static inline __m128i pack_rgb565_lanes(__m128i v) {
+  const __m128i r = _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF8)), 8);
+  const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x7E0));
+  const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 19), _mm_set1_epi32(0x1F));
+  return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+// Mots de 32 bits <= 0xFFFF -> 16 bits : extension du bit 15 pour que packs ne sature pas
+static inline __m128i narrow_u16(__m128i a, __m128i b) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+
+static inline __m128i swap_bytes_16(__m128i v) { return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); }
+
+// Composantes 16 bits (0..255) -> RGB565
+static inline __m128i pack_rgb565_u16(__m128i r, __m128i g, __m128i b) {
+  return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 3), 11), _mm_slli_epi16(_mm_srli_epi16(g, 2), 5)),
+                      _mm_srli_epi16(b, 3));
+}
+
+// RGB565 -> composantes 16 bits, bits de poids fort répliqués comme expand_5bit/expand_6bit
+static inline void expand_rgb565_u16(__m128i v, __m128i &r, __m128i &g, __m128i &b) {
+  r = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 8), _mm_set1_epi16(0xF8)), _mm_srli_epi16(v, 13));
+  g = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 3), _mm_set1_epi16(0xFC)),
+                   _mm_and_si128(_mm_srli_epi16(v, 9), _mm_set1_epi16(0x03)));
+  b = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(v, 3), _mm_set1_epi16(0xF8)),
+                   _mm_and_si128(_mm_srli_epi16(v, 2), _mm_set1_epi16(0x07)));
+}
+
+// 8 pixels en composantes 16 bits -> 24 octets RGB888
+static inline void store_rgb888_x8(uint8_t *dst, __m128i r, __m128i g, __m128i b) {
+  const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+  uint32_t lanes[8];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_unpacklo_epi16(rg, b));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes + 4), _mm_unpackhi_epi16(rg, b));
+  for (int k = 0; k < 8; k++)
+    memcpy(dst + k * 3, &lanes[k], 3);
+}
+
+// 8 pixels YCbCr -> composantes 16 bits bornées, même calcul Q14 que ycbcr_pixel
+static inline void ycbcr_x8(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, __m128i &r, __m128i &g,
+                            __m128i &b) {
+  const __m128i round = _mm_set1_epi32(YCC_ROUND);
+  const __m128i offset = _mm_set1_epi16(128);
+  const __m128i max = _mm_set1_epi16(255);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i yv = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y)), zero);
+  const __m128i db = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(cb)), zero), offset);
+  const __m128i dr = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(cr)), zero), offset);
+  const __m128i lo = _mm_unpacklo_epi16(db, dr);
+  const __m128i hi = _mm_unpackhi_epi16(db, dr);
+  // Produit scalaire (Cb, Cr) . coefficients sur 32 bits, puis retour en 16 bits
+  auto channel = [&](__m128i coef) {
+    const __m128i a = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(lo, coef), round), YCC_SHIFT);
+    const __m128i c = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(hi, coef), round), YCC_SHIFT);
+    return _mm_max_epi16(_mm_min_epi16(_mm_add_epi16(yv, _mm_packs_epi32(a, c)), max), zero);
+  };
+  r = channel(ycc_coef_pair(0, YCC_CR_R));
+  g = channel(ycc_coef_pair(YCC_CB_G, YCC_CR_G));
+  b = channel(ycc_coef_pair(YCC_CB_B, 0));
+}
+
+// Luminance de 4 mots r | g << 8 | b << 16 : mêmes opérations flottantes, dans le
+// même ordre et avec la même troncature, que rgb_to_luma
+static inline __m128i luma_lanes(__m128i v) {
+  const __m128i mask = _mm_set1_epi32(0xFF);
+  const __m128 r = _mm_cvtepi32_ps(_mm_and_si128(v, mask));
+  const __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask));
+  const __m128 b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask));
+  const __m128 rg = _mm_add_ps(_mm_mul_ps(r, _mm_set1_ps(0.299f)), _mm_mul_ps(g, _mm_set1_ps(0.587f)));
+  return _mm_cvttps_epi32(_mm_add_ps(rg, _mm_mul_ps(b, _mm_set1_ps(0.114f))));
+}
+#endif
+
+#if defined(__AVX2__)
+static inline __m256i ycc_coef_pair_256(int16_t cb_coef, int16_t cr_coef) {
+  return _mm256_set1_epi32(static_cast<uint16_t>(cb_coef) |
+                           static_cast<uint32_t>(static_cast<uint16_t>(cr_coef)) << 16);
+}
+
+// 8 pixels RGB888 en mots de 32 bits ; même débordement d'un octet que load_rgb888_x4
+static inline __m256i load_rgb888_x8(const uint8_t *src) {
+  const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+  return _mm256_i32gather_epi32(reinterpret_cast<const int *>(src), offsets, 1);
+}
+
+static inline __m256i pack_rgb565_lanes_256(__m256i v) {
+  const __m256i r = _mm256_slli_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0xF8)), 8);
+  const __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x7E0));
+  const __m256i b = _mm256_and_si256(_mm256_srli_epi32(v, 19), _mm256_set1_epi32(0x1F));
+  return _mm256_or_si256(_mm256_or_si256(r, g), b);
+}
+
+// packs opère par moitié de 128 bits : permute remet a puis b dans l'ordre
+static inline __m256i narrow_u16_256(__m256i a, __m256i b) {
+  const __m256i packed = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16),
+                                            _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16));
+  return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+static inline __m256i swap_bytes_16_256(__m256i v) {
+  return _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+}
+
+static inline __m256i pack_rgb565_u16_256(__m256i r, __m256i g, __m256i b) {
+  return _mm256_or_si256(
+      _mm256_or_si256(_mm256_slli_epi16(_mm256_srli_epi16(r, 3), 11), _mm256_slli_epi16(_mm256_srli_epi16(g, 2), 5)),
+      _mm256_srli_epi16(b, 3));
+}
+
+static inline void expand_rgb565_u16_256(__m256i v, __m256i &r, __m256i &g, __m256i &b) {
+  r = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 8), _mm256_set1_epi16(0xF8)), _mm256_srli_epi16(v, 13));
+  g = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 3), _mm256_set1_epi16(0xFC)),
+                      _mm256_and_si256(_mm256_srli_epi16(v, 9), _mm256_set1_epi16(0x03)));
+  b = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(v, 3), _mm256_set1_epi16(0xF8)),
+                      _mm256_and_si256(_mm256_srli_epi16(v, 2), _mm256_set1_epi16(0x07)));
+}
+
+// unpack opère par moitié : lo = pixels 0-3 et 8-11, hi = 4-7 et 12-15
+static inline void store_rgb888_x16(uint8_t *dst, __m256i r, __m256i g, __m256i b) {
+  const __m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+  const __m256i lo = _mm256_unpacklo_epi16(rg, b);
+  const __m256i hi = _mm256_unpackhi_epi16(rg, b);
+  uint32_t lanes[16];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), _mm256_permute2x128_si256(lo, hi, 0x20));
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+  for (int k = 0; k < 16; k++)
+    memcpy(dst + k * 3, &lanes[k], 3);
+}
+
+// unpack puis packs par moitié de 128 bits se compensent : les pixels restent dans l'ordre
+static inline void ycbcr_x16(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, __m256i &r, __m256i &g,
+                             __m256i &b) {
+  const __m256i round = _mm256_set1_epi32(YCC_ROUND);
+  const __m256i offset = _mm256_set1_epi16(128);
+  const __m256i max = _mm256_set1_epi16(255);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i yv = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(y)));
+  const __m256i db = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(cb))), offset);
+  const __m256i dr = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(cr))), offset);
+  const __m256i lo = _mm256_unpacklo_epi16(db, dr);
+  const __m256i hi = _mm256_unpackhi_epi16(db, dr);
+  auto channel = [&](__m256i coef) {
+    const __m256i a = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(lo, coef), round), YCC_SHIFT);
+    const __m256i c = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(hi, coef), round), YCC_SHIFT);
+    return _mm256_max_epi16(_mm256_min_epi16(_mm256_add_epi16(yv, _mm256_packs_epi32(a, c)), max), zero);
+  };
+  r = channel(ycc_coef_pair_256(0, YCC_CR_R));
+  g = channel(ycc_coef_pair_256(YCC_CB_G, YCC_CR_G));
+  b = channel(ycc_coef_pair_256(YCC_CB_B, 0));
+}
+
+static inline __m256i luma_lanes_256(__m256i v) {
+  const __m256i mask = _mm256_set1_epi32(0xFF);
+  const __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(v, mask));
+  const __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 8), mask));
+  const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 16), mask));
+  const __m256 rg = _mm256_add_ps(_mm256_mul_ps(r, _mm256_set1_ps(0.299f)), _mm256_mul_ps(g, _mm256_set1_ps(0.587f)));
+  return _mm256_cvttps_epi32(_mm256_add_ps(rg, _mm256_mul_ps(b, _mm256_set1_ps(0.114f))));
+}
+#endif
+
+// Seuils par colonne modulo 4 : identiques pour un seuil fixe, ligne de Bayer sinon.
+// start doit être un multiple de 8
+static void binarize_scalar(const uint8_t *src, uint8_t *dst, size_t start, size_t count,
+                            const uint8_t thresholds[4]) {
+  for (size_t i = start; i < count; i += 8) {
+    const size_t n = std::min<size_t>(8, count - i);
+    uint8_t byte = 0;
+    for (size_t bit = 0; bit < n; bit++) {
+      if (src[i + bit] > thresholds[(i + bit) & 3])
+        byte |= 0x80 >> bit;
+    }
+    dst[i / 8] = byte;
+  }
+}
+
+// Traite les pixels par blocs de 16/32 et renvoie l'index du premier pixel restant
+// Build scalaire (ESP32) : aucun bloc SIMD, les paramètres ne sont pas utilisés
+static size_t binarize_simd([[maybe_unused]] const uint8_t *src, [[maybe_unused]] uint8_t *dst,
+                            [[maybe_unused]] size_t count, [[maybe_unused]] const uint8_t thresholds[4]) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  {
+    const __m256i thr = _mm256_set1_epi32(thresholds[0] | thresholds[1] << 8 | thresholds[2] << 16 |
+                                          static_cast<uint32_t>(thresholds[3]) << 24);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= count; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+      // Soustraction saturée non nulle <=> pixel strictement au-dessus du seuil
+      const __m256i off = _mm256_cmpeq_epi8(_mm256_subs_epu8(v, thr), zero);
+      const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(off));
+      dst[i / 8] = reverse_bits(mask);
+      dst[i / 8 + 1] = reverse_bits(mask >> 8);
+      dst[i / 8 + 2] = reverse_bits(mask >> 16);
+      dst[i / 8 + 3] = reverse_bits(mask >> 24);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  {
+    const __m128i thr = _mm_set1_epi32(thresholds[0] | thresholds[1] << 8 | thresholds[2] << 16 |
+                                       static_cast<uint32_t>(thresholds[3]) << 24);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+      const __m128i off = _mm_cmpeq_epi8(_mm_subs_epu8(v, thr), zero);
+      const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(off));
+      dst[i / 8] = reverse_bits(mask);
+      dst[i / 8 + 1] = reverse_bits(mask >> 8);
+    }
+  }
+#endif
+  return i;
+}
+
+// Les blocs qui lisent du RGB888 par mots de 32 bits débordent d'un octet :
+// ils exigent qu'au moins un pixel suive le bloc (i + N < count)
+void rgb888_to_rgb565_row(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 16 < count; i += 16) {
+    __m256i v = narrow_u16_256(pack_rgb565_lanes_256(load_rgb888_x8(src + i * 3)),
+                               pack_rgb565_lanes_256(load_rgb888_x8(src + i * 3 + 24)));
+    if (big_endian)
+      v = swap_bytes_16_256(v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2), v);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 8 < count; i += 8) {
+    __m128i v = narrow_u16(pack_rgb565_lanes(load_rgb888_x4(src + i * 3)),
+                           pack_rgb565_lanes(load_rgb888_x4(src + i * 3 + 12)));
+    if (big_endian)
+      v = swap_bytes_16(v);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), v);
+  }
+#endif
+  for (; i < count; i++)
+    store_rgb565(dst + i * 2, pack_rgb565(src[i * 3], src[i * 3 + 1], src[i * 3 + 2]), big_endian);
+}
+
+void rgb565_to_rgb888_row(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 16 <= count; i += 16) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 2));
+    if (big_endian)
+      v = swap_bytes_16_256(v);
+    __m256i r, g, b;
+    expand_rgb565_u16_256(v, r, g, b);
+    store_rgb888_x16(dst + i * 3, r, g, b);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2));
+    if (big_endian)
+      v = swap_bytes_16(v);
+    __m128i r, g, b;
+    expand_rgb565_u16(v, r, g, b);
+    store_rgb888_x8(dst + i * 3, r, g, b);
+  }
+#endif
+  for (; i < count; i++) {
+    const uint8_t *p = src + i * 2;
+    const uint16_t value = big_endian ? (p[0] << 8 | p[1]) : (p[1] << 8 | p[0]);
+    dst[i * 3] = expand_5bit(value >> 11);
+    dst[i * 3 + 1] = expand_6bit((value >> 5) & 0x3F);
+    dst[i * 3 + 2] = expand_5bit(value & 0x1F);
+  }
+}
+
+void ycbcr_to_rgb888_row(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint8_t *dst, size_t count) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 16 <= count; i += 16) {
+    __m256i r, g, b;
+    ycbcr_x16(y + i, cb + i, cr + i, r, g, b);
+    store_rgb888_x16(dst + i * 3, r, g, b);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 8 <= count; i += 8) {
+    __m128i r, g, b;
+    ycbcr_x8(y + i, cb + i, cr + i, r, g, b);
+    store_rgb888_x8(dst + i * 3, r, g, b);
+  }
+#endif
+  for (; i < count; i++)
+    ycbcr_pixel(y[i], cb[i], cr[i], dst[i * 3], dst[i * 3 + 1], dst[i * 3 + 2]);
+}
+
+void ycbcr_to_rgb565_row(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint8_t *dst, size_t count,
+                         bool big_endian) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 16 <= count; i += 16) {
+    __m256i r, g, b;
+    ycbcr_x16(y + i, cb + i, cr + i, r, g, b);
+    __m256i rgb = pack_rgb565_u16_256(r, g, b);
+    if (big_endian)
+      rgb = swap_bytes_16_256(rgb);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2), rgb);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 8 <= count; i += 8) {
+    __m128i r, g, b;
+    ycbcr_x8(y + i, cb + i, cr + i, r, g, b);
+    __m128i rgb = pack_rgb565_u16(r, g, b);
+    if (big_endian)
+      rgb = swap_bytes_16(rgb);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), rgb);
+  }
+#endif
+  for (; i < count; i++) {
+    uint8_t r, g, b;
+    ycbcr_pixel(y[i], cb[i], cr[i], r, g, b);
+    store_rgb565(dst + i * 2, pack_rgb565(r, g, b), big_endian);
+  }
+}
+
+void rgb888_to_luma_row(const uint8_t *src, uint8_t *dst, size_t count) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 16 < count; i += 16) {
+    const __m256i words = narrow_u16_256(luma_lanes_256(load_rgb888_x8(src + i * 3)),
+                                         luma_lanes_256(load_rgb888_x8(src + i * 3 + 24)));
+    const __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), bytes);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 < count; i += 16) {
+    const __m128i lo = _mm_packs_epi32(luma_lanes(load_rgb888_x4(src + i * 3)),
+                                       luma_lanes(load_rgb888_x4(src + i * 3 + 12)));
+    const __m128i hi = _mm_packs_epi32(luma_lanes(load_rgb888_x4(src + i * 3 + 24)),
+                                       luma_lanes(load_rgb888_x4(src + i * 3 + 36)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+  }
+#endif
+  for (; i < count; i++)
+    dst[i] = rgb_to_luma(src[i * 3], src[i * 3 + 1], src[i * 3 + 2]);
+}
+
+void luma_to_binary_row(const uint8_t *src, uint8_t *dst, size_t count, uint8_t threshold) {
+  const uint8_t thresholds[4] = {threshold, threshold, threshold, threshold};
+  const size_t done = binarize_simd(src, dst, count, thresholds);
+  binarize_scalar(src, dst, done, count, thresholds);
+}
+
+void luma_to_binary_dither_row(const uint8_t *src, uint8_t *dst, size_t count, int row) {
+  const uint8_t *thresholds = BAYER_4X4[row & 3];
+  const size_t done = binarize_simd(src, dst, count, thresholds);
+  binarize_scalar(src, dst, done, count, thresholds);
+}
+
+void premultiply_rgba8888_row(uint8_t *pixels, size_t count) {
+  size_t i = 0;
+  // c * a / 255 arrondi sans division : x = c * a + 128, (x + (x >> 8)) >> 8.
+  // x tient sur 16 bits non signés, le calcul vectoriel est donc identique
+#if defined(__AVX2__)
+  {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bias = _mm256_set1_epi16(128);
+    const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    auto premultiply = [&](__m256i v) {
+      const __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)),
+                                               _MM_SHUFFLE(3, 3, 3, 3));
+      const __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(v, a), bias);
+      return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    };
+    for (; i + 8 <= count; i += 8) {
+      __m256i *ptr = reinterpret_cast<__m256i *>(pixels + i * 4);
+      const __m256i v = _mm256_loadu_si256(ptr);
+      const __m256i lo = premultiply(_mm256_unpacklo_epi8(v, zero));
+      const __m256i hi = premultiply(_mm256_unpackhi_epi8(v, zero));
+      const __m256i rgb = _mm256_andnot_si256(alpha_mask, _mm256_packus_epi16(lo, hi));
+      _mm256_storeu_si256(ptr, _mm256_or_si256(rgb, _mm256_and_si256(v, alpha_mask)));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    auto premultiply = [&](__m128i v) {
+      const __m128i a =
+          _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+      const __m128i x = _mm_add_epi16(_mm_mullo_epi16(v, a), bias);
+      return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    };
+    for (; i + 4 <= count; i += 4) {
+      __m128i *ptr = reinterpret_cast<__m128i *>(pixels + i * 4);
+      const __m128i v = _mm_loadu_si128(ptr);
+      const __m128i lo = premultiply(_mm_unpacklo_epi8(v, zero));
+      const __m128i hi = premultiply(_mm_unpackhi_epi8(v, zero));
+      const __m128i rgb = _mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo, hi));
+      _mm_storeu_si128(ptr, _mm_or_si128(rgb, _mm_and_si128(v, alpha_mask)));
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    uint8_t *p = pixels + i * 4;
+    const unsigned a = p[3];
+    for (int c = 0; c < 3; c++) {
+      const unsigned x = p[c] * a + 128;
+      p[c] = (x + (x >> 8)) >> 8;
+    }
+  }
+}
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace image {
+
+// Conversions de format de pixels par lignes, partagées par les décodeurs et le dessin.
+// Chaque fonction a une version scalaire ; les versions SSE2/AVX2 sont choisies à la
+// compilation (build host) et produisent exactement les mêmes octets.
+
+// Expansion 5/6 bits -> 8 bits par réplication des bits de poids fort
+inline uint8_t expand_5bit(uint8_t value) { return (value << 3) | (value >> 2); }
+inline uint8_t expand_6bit(uint8_t value) { return (value << 2) | (value >> 4); }
+
+inline uint16_t pack_rgb565(uint8_t r, uint8_t g, uint8_t b) { return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3); }
+
+// Luminance BT.601, expression flottante historique de decode_png_data conservée telle
+// quelle (tronquée) : aucun calcul entier ne reproduit exactement ses arrondis.
+// Les versions SIMD effectuent les mêmes opérations dans le même ordre
+inline uint8_t rgb_to_luma(uint8_t r, uint8_t g, uint8_t b) {
+  return (uint8_t) (0.299f * r + 0.587f * g + 0.114f * b);
+}
+
+// RGB888 (3 octets/pixel) <-> RGB565 (2 octets/pixel, ordre des octets au choix)
+void rgb888_to_rgb565_row(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian);
+void rgb565_to_rgb888_row(const uint8_t *src, uint8_t *dst, size_t count, bool big_endian);
+
+// YCbCr pleine échelle (JFIF) en plans séparés -> RGB888 / RGB565
+void ycbcr_to_rgb888_row(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint8_t *dst, size_t count);
+void ycbcr_to_rgb565_row(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint8_t *dst, size_t count,
+                         bool big_endian);
+
+// RGB888 -> luminance 8 bits
+void rgb888_to_luma_row(const uint8_t *src, uint8_t *dst, size_t count);
+
+// Luminance -> 1 bpp (bit de poids fort à gauche, dernier octet complété par des zéros).
+// Un pixel est allumé si sa luminance est strictement supérieure au seuil
+void luma_to_binary_row(const uint8_t *src, uint8_t *dst, size_t count, uint8_t threshold);
+// Variante avec tramage ordonné (matrice de Bayer 4x4) ; row sélectionne la ligne de la matrice
+void luma_to_binary_dither_row(const uint8_t *src, uint8_t *dst, size_t count, int row);
+
+// Prémultiplication RGBA8888 en place : c = round(c * a / 255), alpha inchangé
+void premultiply_rgba8888_row(uint8_t *pixels, size_t count);
+
+}  // namespace image
+}  // namespace esphome
@@ -0,0 +1,4 @@
+// Stub minimal pour les tests host
+#pragma once
+
+inline int esp_task_wdt_reset() { return 0; }
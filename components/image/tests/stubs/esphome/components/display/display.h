@@ -0,0 +1,62 @@
+// Stub minimal pour les tests host : sous-ensemble de l'API ESPHome utilisé par le composant
+#pragma once
+#include "esphome/core/color.h"
+#include <cstddef>
+
+namespace esphome {
+namespace display {
+
+const Color COLOR_OFF(0, 0, 0, 0);
+const Color COLOR_ON(255, 255, 255, 255);
+
+struct Rect {
+  int16_t x{0};
+  int16_t y{0};
+  int16_t w{0};
+  int16_t h{0};
+  bool is_set() const { return this->w > 0 && this->h > 0; }
+  int16_t x2() const { return this->x + this->w; }
+  int16_t y2() const { return this->y + this->h; }
+};
+
+enum ColorOrder : uint8_t { COLOR_ORDER_RGB = 0, COLOR_ORDER_BGR = 1, COLOR_ORDER_GRB = 2 };
+enum ColorBitness : uint8_t { COLOR_BITNESS_888 = 0, COLOR_BITNESS_565 = 1, COLOR_BITNESS_332 = 2 };
+
+// Les tests dérivent de Display pour observer les pixels dessinés
+class Display {
+ public:
+  virtual ~Display() = default;
+  virtual void draw_pixel_at(int /*x*/, int /*y*/, Color /*color*/) {}
+  // Comme ESPHome : un draw_pixel_at par pixel (seuls RGB888/RGB565 en ordre RGB)
+  virtual void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder /*order*/,
+                              ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+    const size_t line_stride = x_offset + w + x_pad;
+    for (int y = 0; y != h; y++) {
+      for (int x = 0; x != w; x++) {
+        const size_t index = (y_offset + y) * line_stride + x_offset + x;
+        Color color;
+        if (bitness == COLOR_BITNESS_565) {
+          const uint8_t *p = ptr + index * 2;
+          const uint16_t v = big_endian ? (p[0] << 8 | p[1]) : (p[1] << 8 | p[0]);
+          color = Color((v >> 11) << 3, ((v >> 5) & 0x3F) << 2, (v & 0x1F) << 3);
+        } else {
+          const uint8_t *p = ptr + index * 3;
+          color = big_endian ? Color(p[0], p[1], p[2]) : Color(p[2], p[1], p[0]);
+        }
+        this->draw_pixel_at(x + x_start, y + y_start, color);
+      }
+    }
+  }
+  virtual Rect get_clipping() const { return {}; }
+};
+
+class BaseImage {
+ public:
+  virtual ~BaseImage() = default;
+  virtual void draw(int x, int y, Display *display, Color color_on, Color color_off) = 0;
+  virtual int get_width() const = 0;
+  virtual int get_height() const = 0;
+};
+
+}  // namespace display
+}  // namespace esphome
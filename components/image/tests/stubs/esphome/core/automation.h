@@ -0,0 +1,11 @@
+// Stub minimal pour les tests host : sous-ensemble de l'API ESPHome utilisé par le composant
+#pragma once
+
+namespace esphome {
+
+template<typename... Ts> class Action {
+ public:
+  virtual void play(Ts... x) = 0;
+};
+
+}  // namespace esphome
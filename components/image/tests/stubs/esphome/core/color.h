@@ -0,0 +1,19 @@
+// Stub minimal pour les tests host : sous-ensemble de l'API ESPHome utilisé par le composant
+#pragma once
+#include <cstdint>
+
+namespace esphome {
+
+struct Color {
+  union {
+    struct {
+      uint8_t r, g, b, w;
+    };
+    uint8_t raw[4];
+    uint32_t raw_32;
+  };
+  Color() : r(0), g(0), b(0), w(0) {}
+  Color(uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0xFF) : r(r), g(g), b(b), w(w) {}
+};
+
+}  // namespace esphome
@@ -0,0 +1,23 @@
+// Stub minimal pour les tests host : sous-ensemble de l'API ESPHome utilisé par le composant
+#pragma once
+
+namespace esphome {
+
+namespace setup_priority {
+const float HARDWARE = 800.0f;
+}  // namespace setup_priority
+
+class Component {
+ public:
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual float get_setup_priority() const { return 0.0f; }
+  void mark_failed() { this->failed_ = true; }
+  bool is_failed() const { return this->failed_; }
+
+ protected:
+  bool failed_{false};
+};
+
+}  // namespace esphome
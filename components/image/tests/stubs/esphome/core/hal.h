@@ -0,0 +1,2 @@
+// Stub minimal pour les tests host
+#pragma once
@@ -0,0 +1,10 @@
+// Stub minimal pour les tests host : seuls les erreurs et avertissements sont affichés
+#pragma once
+#include <cstdio>
+
+#define ESP_LOGE(tag, ...) (fprintf(stderr, "E [%s] ", tag), fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#define ESP_LOGW(tag, ...) (fprintf(stderr, "W [%s] ", tag), fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#define ESP_LOGI(tag, ...) ((void) 0)
+#define ESP_LOGD(tag, ...) ((void) 0)
+#define ESP_LOGV(tag, ...) ((void) 0)
+#define ESP_LOGCONFIG(tag, ...) ((void) 0)
@@ -0,0 +1,185 @@
+// Compositeur : opérateur "over" avec opacité partielle comparé à une référence
+// flottante, pixels masqués par une couche opaque jamais lus, clipping, et chaque
+// pixel destination émis une seule fois (par plages via draw_pixels_at)
+#include "compositor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::image;
+
+namespace {
+
+const int WIDTH = 40;
+const int HEIGHT = 24;
+
+class RecordingDisplay : public display::Display {
+ public:
+  RecordingDisplay() : pixels(WIDTH * HEIGHT), drawn(WIDTH * HEIGHT) {}
+  void draw_pixel_at(int x, int y, Color color) override {
+    assert(x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT);
+    if (this->clipping.is_set())
+      assert(x >= this->clipping.x && x < this->clipping.x2() && y >= this->clipping.y && y < this->clipping.y2());
+    assert(!this->drawn[y * WIDTH + x]);
+    this->drawn[y * WIDTH + x] = true;
+    this->pixels[y * WIDTH + x] = color;
+    if (!this->in_run)
+      this->single_pixels++;
+  }
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                      display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override {
+    assert(w > 1 && h == 1 && order == display::COLOR_ORDER_RGB && bitness == display::COLOR_BITNESS_888);
+    this->runs++;
+    this->in_run = true;
+    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
+                                     x_pad);
+    this->in_run = false;
+  }
+  display::Rect get_clipping() const override { return this->clipping; }
+
+  display::Rect clipping;
+  std::vector<Color> pixels;
+  std::vector<bool> drawn;
+  int runs{0};
+  int single_pixels{0};
+  bool in_run{false};
+};
+
+std::vector<uint8_t> random_bytes(size_t size) {
+  std::vector<uint8_t> data(size);
+  for (uint8_t &b : data)
+    b = rand();
+  return data;
+}
+
+// "over" en flottant, non prémultiplié en sortie : renvoie l'alpha composé
+double reference_pixel(const std::vector<CompositorLayer> &layers, int x, int y, double rgb[3]) {
+  double a = 0;
+  rgb[0] = rgb[1] = rgb[2] = 0;
+  for (auto &layer : layers) {
+    const int sx = x - layer.x, sy = y - layer.y;
+    if (sx < 0 || sy < 0 || sx >= layer.image->get_width() || sy >= layer.image->get_height())
+      continue;
+    Color s = layer.image->get_pixel(sx, sy);
+    if (!layer.image->has_transparency())
+      s.w = 255;
+    const double sa = s.w / 255.0 * layer.opacity / 255.0;
+    rgb[0] = s.r * sa + rgb[0] * (1 - sa);
+    rgb[1] = s.g * sa + rgb[1] * (1 - sa);
+    rgb[2] = s.b * sa + rgb[2] * (1 - sa);
+    a = sa + a * (1 - sa);
+  }
+  if (a > 0) {
+    for (int k = 0; k < 3; k++)
+      rgb[k] /= a;
+  }
+  return a;
+}
+
+// Couches alpha et opacités partielles : couleur à ±2 près de la référence flottante
+// (arrondis entiers successifs), couverture identique hors zone d'ambiguïté du seuil
+void test_blend_partial_opacity() {
+  const auto background = random_bytes(30 * 20 * 3);
+  auto icon = random_bytes(10 * 10 * 4);
+  const auto overlay = random_bytes(30 * 5 * 4);
+  for (int i = 20; i < 60; i++)
+    icon[i * 4 + 3] = 255;
+  Image bg(background.data(), 30, 20, IMAGE_TYPE_RGB, TRANSPARENCY_OPAQUE);
+  Image ic(icon.data(), 10, 10, IMAGE_TYPE_RGB, TRANSPARENCY_ALPHA_CHANNEL);
+  Image ov(overlay.data(), 30, 5, IMAGE_TYPE_RGB, TRANSPARENCY_ALPHA_CHANNEL);
+  const std::vector<CompositorLayer> layers = {{&bg, 0, 0, 255}, {&ic, 5, 3, 255}, {&ov, 2, 12, 200},
+                                               {&ic, 25, 8, 90}, {&ic, 30, 14, 255}};
+  Compositor compositor;
+  for (auto &layer : layers)
+    compositor.add_layer(layer.image, layer.x, layer.y, layer.opacity);
+  RecordingDisplay display;
+  compositor.draw(&display);
+
+  int checked = 0;
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      double rgb[3];
+      const double coverage = reference_pixel(layers, x, y, rgb) * 255;
+      const bool drawn = display.drawn[y * WIDTH + x];
+      if (coverage > 128.5 || coverage < 127)
+        assert(drawn == (coverage >= 128));
+      if (!drawn || coverage < 128.5)
+        continue;
+      const Color got = display.pixels[y * WIDTH + x];
+      assert(std::abs(got.r - lround(rgb[0])) <= 2);
+      assert(std::abs(got.g - lround(rgb[1])) <= 2);
+      assert(std::abs(got.b - lround(rgb[2])) <= 2);
+      checked++;
+    }
+  }
+  assert(checked > 0 && display.runs > 0);
+}
+
+// La couche du bas n'a de pixels que pour ses 10 premières lignes : les 10 suivantes,
+// entièrement recouvertes par une couche opaque, seraient une lecture hors limites
+// (détectée par AddressSanitizer) si le compositeur les lisait
+void test_opaque_occlusion() {
+  const auto bottom = random_bytes(WIDTH * 10 * 3);
+  const auto top = random_bytes(WIDTH * 10 * 3);
+  Image bottom_image(bottom.data(), WIDTH, 20, IMAGE_TYPE_RGB, TRANSPARENCY_OPAQUE);
+  Image top_image(top.data(), WIDTH, 10, IMAGE_TYPE_RGB, TRANSPARENCY_OPAQUE);
+  Compositor compositor;
+  compositor.add_layer(&bottom_image, 0, 0);
+  compositor.add_layer(&top_image, 0, 10);
+  RecordingDisplay display;
+  compositor.draw(&display);
+
+  for (int y = 0; y < 20; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      assert(display.drawn[y * WIDTH + x]);
+      const uint8_t *p = y < 10 ? &bottom[(y * WIDTH + x) * 3] : &top[((y - 10) * WIDTH + x) * 3];
+      const Color got = display.pixels[y * WIDTH + x];
+      assert(got.r == p[0] && got.g == p[1] && got.b == p[2]);
+    }
+  }
+  // Lignes entièrement couvertes : une seule plage chacune, aucun pixel isolé
+  assert(display.runs == 20 && display.single_pixels == 0);
+}
+
+// Avec clipping : rien hors de la zone, et dans la zone les mêmes pixels que sans clipping
+void test_clipping() {
+  const auto background = random_bytes(30 * 20 * 3);
+  auto icon = random_bytes(10 * 10 * 4);
+  Image bg(background.data(), 30, 20, IMAGE_TYPE_RGB, TRANSPARENCY_OPAQUE);
+  Image ic(icon.data(), 10, 10, IMAGE_TYPE_RGB, TRANSPARENCY_ALPHA_CHANNEL);
+  Compositor compositor;
+  compositor.add_layer(&bg, 0, 0);
+  compositor.add_layer(&ic, 24, 12, 180);
+
+  RecordingDisplay full;
+  compositor.draw(&full);
+  RecordingDisplay clipped;
+  clipped.clipping = {7, 4, 22, 14};
+  compositor.draw(&clipped);
+
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < WIDTH; x++) {
+      const bool inside = x >= 7 && x < 29 && y >= 4 && y < 18;
+      const int i = y * WIDTH + x;
+      assert(clipped.drawn[i] == (inside && full.drawn[i]));
+      if (clipped.drawn[i])
+        assert(clipped.pixels[i].raw_32 == full.pixels[i].raw_32);
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  srand(3);
+  test_blend_partial_opacity();
+  test_opaque_occlusion();
+  test_clipping();
+  printf("test_compositor: OK\n");
+  return 0;
+}
@@ -0,0 +1,115 @@
+// Concurrence du buffer SD (RCU) : publications et chargements en parallèle des
+// dessins et lectures de pixels. À lancer sous ThreadSanitizer (make tsan)
+#include "image.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <thread>
+
+using namespace esphome;
+using namespace esphome::image;
+
+namespace {
+
+class CountingDisplay : public display::Display {
+ public:
+  void draw_pixel_at(int x, int y, Color color) override { this->pixels++; }
+  long pixels{0};
+};
+
+ImageBufferRef make_buffer(int width, int height, uint8_t value) {
+  auto buffer = std::make_shared<ImageBuffer>();
+  buffer->width = width;
+  buffer->height = height;
+  buffer->data.assign(width * height * 2, value);
+  return buffer;
+}
+
+// Un instantané reste intact après la publication d'un autre buffer
+void test_snapshot_survives_publish() {
+  Image img(nullptr, 16, 8, IMAGE_TYPE_RGB565, TRANSPARENCY_OPAQUE);
+  img.publish_sd_buffer(make_buffer(16, 8, 0x11));
+  ImageBufferRef snapshot = img.get_sd_buffer();
+  img.publish_sd_buffer(make_buffer(8, 16, 0x22));
+  assert(snapshot->width == 16 && snapshot->height == 8);
+  for (uint8_t b : snapshot->data)
+    assert(b == 0x11);
+  assert(img.get_sd_buffer()->width == 8);
+}
+
+class ReaderImage : public Image {
+ public:
+  using Image::Image;
+  using Image::SdPixels;
+};
+
+// Un buffer remplacé reste lisible tant qu'un lecteur actif a pu le voir, puis
+// est libéré dès la fin du dernier lecteur
+void test_reader_keeps_replaced_buffer() {
+  ReaderImage img(nullptr, 16, 8, IMAGE_TYPE_RGB565, TRANSPARENCY_OPAQUE);
+  ImageBufferRef first = make_buffer(16, 8, 0x11);
+  std::weak_ptr<const ImageBuffer> watch = first;
+  img.publish_sd_buffer(std::move(first));
+  {
+    const ReaderImage::SdPixels reader(&img);
+    img.publish_sd_buffer(make_buffer(8, 16, 0x22));
+    assert(!watch.expired() && reader.get()->data[0] == 0x11);
+    assert(img.get_width() == 8 && img.get_height() == 16 && img.get_width_stride() == 16);
+  }
+  assert(watch.expired());
+  // Sans lecteur actif, la publication libère immédiatement l'ancien buffer
+  watch = img.get_sd_buffer();
+  img.publish_sd_buffer(nullptr);
+  assert(watch.expired() && !img.has_sd_buffer());
+  assert(img.get_width() == 16 && img.get_height() == 8);
+}
+
+// Publications (tailles alternées) et chargements SD concurrents des lectures
+void test_concurrent_publish_and_draw() {
+  Image img(nullptr, 64, 48, IMAGE_TYPE_RGB565, TRANSPARENCY_OPAQUE);
+  img.set_sd_path("/sd/race.jpg");
+  img.set_sd_runtime(true);
+  img.set_sd_file_reader([](const std::string &path, std::vector<uint8_t> &data) {
+    data = {0xFF, 0xD8, 0xFF, 0xD9};
+    return true;
+  });
+  img.publish_sd_buffer(make_buffer(64, 48, 0));
+
+  std::atomic<bool> stop{false};
+  std::thread publisher([&]() {
+    for (int i = 0; i < 2000; i++)
+      img.publish_sd_buffer(i % 2 ? make_buffer(64, 48, i) : make_buffer(48, 64, i));
+  });
+  std::thread loader([&]() {
+    for (int i = 0; i < 200; i++)
+      assert(img.load_from_sd());
+  });
+  std::thread finisher([&]() {
+    publisher.join();
+    loader.join();
+    stop = true;
+  });
+
+  CountingDisplay display;
+  long draws = 0;
+  while (!stop) {
+    img.draw(0, 0, &display, display::COLOR_ON, display::COLOR_OFF);
+    img.draw(0, 0, &display, display::COLOR_ON, display::COLOR_OFF, IMAGE_ROTATION_90, true, false);
+    img.get_pixel(47, 47);
+    assert(img.get_width() * img.get_height() == 64 * 48);
+    draws++;
+  }
+  finisher.join();
+  assert(draws > 0 && display.pixels > 0);
+}
+
+}  // namespace
+
+int main() {
+  test_snapshot_survives_publish();
+  test_reader_keeps_replaced_buffer();
+  test_concurrent_publish_and_draw();
+  printf("test_image_buffer: OK\n");
+  return 0;
+}
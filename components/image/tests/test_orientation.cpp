@@ -0,0 +1,200 @@
+// Orientation : dessin orienté (draw, get_pixel) et orientation appliquée aux
+// pixels SD (apply_sd_orientation_), comparés à une référence naïve pixel par
+// pixel pour les 4 rotations × 4 combinaisons de miroirs et chaque type d'image
+#include "image.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::image;
+
+namespace {
+
+const ImageType TYPES[] = {IMAGE_TYPE_BINARY, IMAGE_TYPE_GRAYSCALE, IMAGE_TYPE_RGB565, IMAGE_TYPE_RGB};
+const ImageRotation ROTATIONS[] = {IMAGE_ROTATION_0, IMAGE_ROTATION_90, IMAGE_ROTATION_180, IMAGE_ROTATION_270};
+// Largeurs non multiples de 8 (binaire) et plus grandes qu'une tuile d'orientation
+const int SIZES[][2] = {{13, 6}, {21, 18}, {1, 9}};
+
+class OrientedImage : public Image {
+ public:
+  using Image::Image;
+  using Image::apply_sd_orientation_;
+};
+
+// Mémorise chaque pixel dessiné et vérifie qu'il ne l'est qu'une fois
+class RecordingDisplay : public display::Display {
+ public:
+  RecordingDisplay(int width, int height) : width(width), height(height), pixels(width * height), drawn(width * height) {}
+  void draw_pixel_at(int x, int y, Color color) override {
+    assert(x >= 0 && x < this->width && y >= 0 && y < this->height);
+    assert(!this->drawn[y * this->width + x]);
+    this->drawn[y * this->width + x] = true;
+    this->pixels[y * this->width + x] = color;
+  }
+  int width;
+  int height;
+  std::vector<Color> pixels;
+  std::vector<bool> drawn;
+};
+
+size_t data_size(ImageType type, int width, int height) {
+  switch (type) {
+    case IMAGE_TYPE_BINARY:
+      return (width + 7) / 8 * height;
+    case IMAGE_TYPE_GRAYSCALE:
+      return width * height;
+    case IMAGE_TYPE_RGB565:
+      return width * height * 2;
+    default:
+      return width * height * 3;
+  }
+}
+
+std::vector<uint8_t> random_data(ImageType type, int width, int height) {
+  std::vector<uint8_t> data(data_size(type, width, height));
+  for (uint8_t &b : data)
+    b = rand();
+  // Bits de remplissage binaires à zéro, comme en sortie des décodeurs
+  if (type == IMAGE_TYPE_BINARY && width % 8 != 0) {
+    const size_t stride = (width + 7) / 8;
+    for (int y = 0; y < height; y++)
+      data[y * stride + stride - 1] &= ~(0xFF >> (width % 8));
+  }
+  return data;
+}
+
+// Référence naïve : position destination du pixel source (sx, sy), miroirs puis rotation horaire
+void reference_position(int width, int height, ImageRotation rotation, bool flip_x, bool flip_y, int sx, int sy,
+                        int &dx, int &dy) {
+  const int fx = flip_x ? width - 1 - sx : sx;
+  const int fy = flip_y ? height - 1 - sy : sy;
+  switch (rotation) {
+    case IMAGE_ROTATION_90:
+      dx = height - 1 - fy;
+      dy = fx;
+      break;
+    case IMAGE_ROTATION_180:
+      dx = width - 1 - fx;
+      dy = height - 1 - fy;
+      break;
+    case IMAGE_ROTATION_270:
+      dx = fy;
+      dy = width - 1 - fx;
+      break;
+    default:
+      dx = fx;
+      dy = fy;
+      break;
+  }
+}
+
+bool same_rgb(Color a, Color b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+
+void check_drawn(const Image &source, const RecordingDisplay &display, ImageRotation rotation, bool flip_x,
+                 bool flip_y) {
+  const int width = source.get_width();
+  const int height = source.get_height();
+  for (bool drawn : display.drawn)
+    assert(drawn);
+  for (int sy = 0; sy < height; sy++) {
+    for (int sx = 0; sx < width; sx++) {
+      int dx, dy;
+      reference_position(width, height, rotation, flip_x, flip_y, sx, sy, dx, dy);
+      assert(same_rgb(display.pixels[dy * display.width + dx], source.get_stored_pixel(sx, sy)));
+    }
+  }
+}
+
+// draw() orienté, draw() avec l'orientation par défaut et get_pixel()
+void test_draw(ImageType type, int width, int height) {
+  const std::vector<uint8_t> data = random_data(type, width, height);
+  Image source(data.data(), width, height, type, TRANSPARENCY_OPAQUE);
+  for (ImageRotation rotation : ROTATIONS) {
+    for (int flips = 0; flips < 4; flips++) {
+      const bool flip_x = flips & 1;
+      const bool flip_y = flips & 2;
+      const bool swapped = rotation == IMAGE_ROTATION_90 || rotation == IMAGE_ROTATION_270;
+      const int dst_w = swapped ? height : width;
+      const int dst_h = swapped ? width : height;
+
+      RecordingDisplay explicit_display(dst_w, dst_h);
+      source.draw(0, 0, &explicit_display, display::COLOR_ON, display::COLOR_OFF, rotation, flip_x, flip_y);
+      check_drawn(source, explicit_display, rotation, flip_x, flip_y);
+
+      Image oriented(data.data(), width, height, type, TRANSPARENCY_OPAQUE);
+      oriented.set_orientation(rotation, flip_x, flip_y);
+      assert(oriented.get_width() == dst_w && oriented.get_height() == dst_h);
+      assert(oriented.get_width_stride() == source.get_width_stride());
+      RecordingDisplay default_display(dst_w, dst_h);
+      oriented.draw(0, 0, &default_display, display::COLOR_ON, display::COLOR_OFF);
+      check_drawn(source, default_display, rotation, flip_x, flip_y);
+
+      for (int sy = 0; sy < height; sy++) {
+        for (int sx = 0; sx < width; sx++) {
+          int dx, dy;
+          reference_position(width, height, rotation, flip_x, flip_y, sx, sy, dx, dy);
+          assert(same_rgb(oriented.get_pixel(dx, dy), source.get_stored_pixel(sx, sy)));
+        }
+      }
+      assert(same_rgb(oriented.get_pixel(dst_w, 0), display::COLOR_OFF));
+      assert(same_rgb(oriented.get_pixel(0, dst_h), display::COLOR_OFF));
+    }
+  }
+}
+
+// apply_sd_orientation_ : pixels réorganisés comme la référence, lignes binaires
+// alignées sur l'octet avec les bits de remplissage à zéro
+void test_sd_orientation(ImageType type, int width, int height) {
+  const std::vector<uint8_t> data = random_data(type, width, height);
+  Image source(data.data(), width, height, type, TRANSPARENCY_OPAQUE);
+  for (ImageRotation rotation : ROTATIONS) {
+    for (int flips = 0; flips < 4; flips++) {
+      const bool flip_x = flips & 1;
+      const bool flip_y = flips & 2;
+      const bool swapped = rotation == IMAGE_ROTATION_90 || rotation == IMAGE_ROTATION_270;
+      const int dst_w = swapped ? height : width;
+      const int dst_h = swapped ? width : height;
+
+      OrientedImage image(nullptr, dst_w, dst_h, type, TRANSPARENCY_OPAQUE);
+      image.set_sd_orientation(rotation, flip_x, flip_y);
+      auto buffer = std::make_shared<ImageBuffer>();
+      buffer->width = width;
+      buffer->height = height;
+      buffer->data = data;
+      image.apply_sd_orientation_(*buffer);
+      assert(buffer->width == dst_w && buffer->height == dst_h);
+      assert(buffer->data.size() == data_size(type, dst_w, dst_h));
+      if (type == IMAGE_TYPE_BINARY && dst_w % 8 != 0) {
+        const size_t stride = (dst_w + 7) / 8;
+        for (int y = 0; y < dst_h; y++)
+          assert((buffer->data[y * stride + stride - 1] & (0xFF >> (dst_w % 8))) == 0);
+      }
+      image.publish_sd_buffer(buffer);
+
+      for (int sy = 0; sy < height; sy++) {
+        for (int sx = 0; sx < width; sx++) {
+          int dx, dy;
+          reference_position(width, height, rotation, flip_x, flip_y, sx, sy, dx, dy);
+          assert(same_rgb(image.get_stored_pixel(dx, dy), source.get_stored_pixel(sx, sy)));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  srand(1);
+  for (ImageType type : TYPES) {
+    for (const auto &size : SIZES) {
+      test_draw(type, size[0], size[1]);
+      test_sd_orientation(type, size[0], size[1]);
+    }
+  }
+  printf("test_orientation: OK\n");
+  return 0;
+}
@@ -0,0 +1,165 @@
+// Exactitude des conversions de pixels : chaque variante (scalaire, SSE2, AVX2)
+// est comparée aux expressions d'origine, et écrit ses sorties pour que le
+// Makefile vérifie que les trois variantes produisent les mêmes octets
+#include "pixel_convert.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace esphome::image;
+
+namespace {
+
+// Longueur non multiple des largeurs SIMD pour couvrir les restes scalaires
+const size_t ROW = 1237;
+
+uint8_t clamp_u8(int value) { return value < 0 ? 0 : (value > 255 ? 255 : value); }
+
+// Expressions d'origine (decode_png_data, get_rgb565_pixel_)
+uint16_t old_pack_rgb565(int r, int g, int b) { return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3); }
+uint8_t old_luma(int r, int g, int b) { return (uint8_t) (0.299f * r + 0.587f * g + 0.114f * b); }
+
+void test_rgb565_pack_expand() {
+  for (int v = 0; v < 65536; v++) {
+    const int r = (v & 0xF800) >> 11, g = (v & 0x07E0) >> 5, b = v & 0x1F;
+    assert(expand_5bit(r) == (uint8_t) ((r << 3) | (r >> 2)));
+    assert(expand_6bit(g) == (uint8_t) ((g << 2) | (g >> 4)));
+    assert(expand_5bit(b) == (uint8_t) ((b << 3) | (b >> 2)));
+    for (int big_endian = 0; big_endian < 2; big_endian++) {
+      const uint8_t src[2] = {(uint8_t) (big_endian ? v >> 8 : v), (uint8_t) (big_endian ? v : v >> 8)};
+      uint8_t dst[3];
+      rgb565_to_rgb888_row(src, dst, 1, big_endian);
+      assert(dst[0] == expand_5bit(r) && dst[1] == expand_6bit(g) && dst[2] == expand_5bit(b));
+    }
+  }
+  for (int r = 0; r < 256; r++) {
+    for (int g = 0; g < 256; g++) {
+      for (int b = 0; b < 256; b++) {
+        const uint16_t expected = old_pack_rgb565(r, g, b);
+        assert(pack_rgb565(r, g, b) == expected);
+        const uint8_t src[3] = {(uint8_t) r, (uint8_t) g, (uint8_t) b};
+        uint8_t le[2], be[2];
+        rgb888_to_rgb565_row(src, le, 1, false);
+        rgb888_to_rgb565_row(src, be, 1, true);
+        assert(le[0] == (expected & 0xFF) && le[1] == expected >> 8);
+        assert(be[0] == expected >> 8 && be[1] == (expected & 0xFF));
+      }
+    }
+  }
+}
+
+// Luminance identique à l'expression d'origine pour toutes les couleurs, en passant
+// par la fonction de ligne pour couvrir aussi les blocs SIMD
+void test_luma() {
+  std::vector<uint8_t> src(65536 * 3), dst(65536);
+  for (int r = 0; r < 256; r++) {
+    for (int i = 0; i < 65536; i++) {
+      src[i * 3] = r;
+      src[i * 3 + 1] = i >> 8;
+      src[i * 3 + 2] = i & 0xFF;
+    }
+    rgb888_to_luma_row(src.data(), dst.data(), 65536);
+    for (int i = 0; i < 65536; i++) {
+      assert(dst[i] == old_luma(r, i >> 8, i & 0xFF));
+      assert(rgb_to_luma(r, i >> 8, i & 0xFF) == dst[i]);
+    }
+  }
+}
+
+void test_rows(FILE *out) {
+  srand(1);
+  std::vector<uint8_t> a(ROW * 4), b(ROW * 4), c(ROW * 4), dst(ROW * 4);
+  for (int iteration = 0; iteration < 200; iteration++) {
+    for (size_t i = 0; i < ROW * 4; i++) {
+      a[i] = rand();
+      b[i] = rand();
+      c[i] = rand();
+    }
+    const size_t n = iteration == 0 ? ROW : rand() % ROW;
+
+    // YCbCr : formule JFIF en virgule fixe Q14
+    ycbcr_to_rgb888_row(a.data(), b.data(), c.data(), dst.data(), n);
+    fwrite(dst.data(), 1, n * 3, out);
+    for (size_t i = 0; i < n; i++) {
+      const int db = b[i] - 128, dr = c[i] - 128;
+      assert(dst[i * 3] == clamp_u8(a[i] + ((22970 * dr + 8192) >> 14)));
+      assert(dst[i * 3 + 1] == clamp_u8(a[i] + ((-5638 * db - 11700 * dr + 8192) >> 14)));
+      assert(dst[i * 3 + 2] == clamp_u8(a[i] + ((29032 * db + 8192) >> 14)));
+    }
+    std::vector<uint8_t> rgb(dst.begin(), dst.begin() + n * 3);
+    for (int big_endian = 0; big_endian < 2; big_endian++) {
+      ycbcr_to_rgb565_row(a.data(), b.data(), c.data(), dst.data(), n, big_endian);
+      fwrite(dst.data(), 1, n * 2, out);
+      for (size_t i = 0; i < n; i++) {
+        const uint16_t expected = old_pack_rgb565(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+        const uint16_t got = big_endian ? (dst[i * 2] << 8 | dst[i * 2 + 1]) : (dst[i * 2 + 1] << 8 | dst[i * 2]);
+        assert(got == expected);
+      }
+    }
+
+    // RGB888 <-> RGB565 dans les deux ordres d'octets
+    for (int big_endian = 0; big_endian < 2; big_endian++) {
+      rgb888_to_rgb565_row(a.data(), dst.data(), n, big_endian);
+      fwrite(dst.data(), 1, n * 2, out);
+      for (size_t i = 0; i < n; i++) {
+        const uint16_t expected = old_pack_rgb565(a[i * 3], a[i * 3 + 1], a[i * 3 + 2]);
+        const uint16_t got = big_endian ? (dst[i * 2] << 8 | dst[i * 2 + 1]) : (dst[i * 2 + 1] << 8 | dst[i * 2]);
+        assert(got == expected);
+      }
+      rgb565_to_rgb888_row(a.data(), dst.data(), n, big_endian);
+      fwrite(dst.data(), 1, n * 3, out);
+      for (size_t i = 0; i < n; i++) {
+        const int v = big_endian ? (a[i * 2] << 8 | a[i * 2 + 1]) : (a[i * 2 + 1] << 8 | a[i * 2]);
+        const int r = v >> 11, g = (v >> 5) & 0x3F, b = v & 0x1F;
+        assert(dst[i * 3] == ((r << 3) | (r >> 2)) && dst[i * 3 + 1] == ((g << 2) | (g >> 4)) &&
+               dst[i * 3 + 2] == ((b << 3) | (b >> 2)));
+      }
+    }
+
+    rgb888_to_luma_row(a.data(), dst.data(), n);
+    fwrite(dst.data(), 1, n, out);
+    for (size_t i = 0; i < n; i++)
+      assert(dst[i] == old_luma(a[i * 3], a[i * 3 + 1], a[i * 3 + 2]));
+
+    // 1 bpp : bit de poids fort à gauche, allumé si strictement au-dessus du seuil
+    const uint8_t thresholds[] = {a[0], 0, 254, 255};
+    for (uint8_t threshold : thresholds) {
+      luma_to_binary_row(a.data(), dst.data(), n, threshold);
+      fwrite(dst.data(), 1, (n + 7) / 8, out);
+      for (size_t i = 0; i < n; i++)
+        assert(((dst[i / 8] >> (7 - i % 8)) & 1) == (a[i] > threshold));
+    }
+    static const uint8_t BAYER[4][4] = {
+        {8, 136, 40, 168}, {200, 72, 232, 104}, {56, 184, 24, 152}, {248, 120, 216, 88}};
+    luma_to_binary_dither_row(a.data(), dst.data(), n, iteration);
+    fwrite(dst.data(), 1, (n + 7) / 8, out);
+    for (size_t i = 0; i < n; i++)
+      assert(((dst[i / 8] >> (7 - i % 8)) & 1) == (a[i] > BAYER[iteration & 3][i & 3]));
+
+    // Prémultiplication : round(c * a / 255), alpha inchangé
+    dst = a;
+    premultiply_rgba8888_row(dst.data(), n);
+    fwrite(dst.data(), 1, n * 4, out);
+    for (size_t i = 0; i < n; i++) {
+      const uint8_t *p = &a[i * 4];
+      for (int k = 0; k < 3; k++)
+        assert(dst[i * 4 + k] == (p[k] * p[3] * 2 + 255) / 510);
+      assert(dst[i * 4 + 3] == p[3]);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  FILE *out = fopen(argc > 1 ? argv[1] : "/dev/null", "wb");
+  assert(out != nullptr);
+  test_rgb565_pack_expand();
+  test_luma();
+  test_rows(out);
+  fclose(out);
+  printf("test_pixel_convert: OK\n");
+  return 0;
+}
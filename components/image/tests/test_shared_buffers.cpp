@@ -0,0 +1,104 @@
+// Registre des buffers SD partagés : une lecture par clé, chargements concurrents
+// regroupés, callbacks de prefetch sans interblocage. À lancer sous ThreadSanitizer
+#include "image.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace esphome;
+using namespace esphome::image;
+
+namespace {
+
+std::atomic<int> reads{0};
+
+bool slow_reader(const std::string &path, std::vector<uint8_t> &data) {
+  reads++;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  data = {0xFF, 0xD8, 0xFF, 0xD9};
+  return true;
+}
+
+Image *make_image(const std::string &path) {
+  auto *image = new Image(nullptr, 20, 10, IMAGE_TYPE_RGB565, TRANSPARENCY_OPAQUE);
+  image->set_sd_path(path);
+  image->set_sd_runtime(true);
+  return image;
+}
+
+// Chargements concurrents de la même clé : un seul fichier lu, un seul buffer
+void test_concurrent_loads_coalesce() {
+  reads = 0;
+  std::vector<Image *> images;
+  for (int i = 0; i < 4; i++)
+    images.push_back(make_image("/sd/shared.jpg"));
+  std::vector<std::thread> threads;
+  for (Image *image : images)
+    threads.emplace_back([image]() { assert(image->load_from_sd()); });
+  for (auto &thread : threads)
+    thread.join();
+  assert(reads == 1);
+  for (Image *image : images)
+    assert(image->get_sd_buffer() == images[0]->get_sd_buffer());
+
+  // Rechargement explicite : le fichier est relu
+  assert(images[0]->load_from_sd());
+  assert(reads == 2);
+}
+
+// Un callback de prefetch qui charge une image dont la clé est plus loin dans le lot
+void test_prefetch_callback_loads_later_key() {
+  Image *first = make_image("/sd/a.jpg");
+  Image *later = make_image("/sd/z.jpg");
+  Image *other = make_image("/sd/z.jpg");
+  first->add_on_load_callback([other](bool ok) { assert(ok && other->load_from_sd()); });
+  auto start = std::chrono::steady_clock::now();
+  Image::prefetch({first, later});
+  assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+  assert(other->get_sd_buffer() == later->get_sd_buffer());
+}
+
+// Pendant un prefetch de fond, charger la dernière image du lot n'attend pas tout le lot
+void test_async_prefetch_does_not_hold_later_keys() {
+  std::vector<Image *> batch;
+  for (int i = 0; i < 10; i++)
+    batch.push_back(make_image("/sd/page/" + std::to_string(i) + ".jpg"));
+  Image *last = make_image("/sd/page/9.jpg");
+  Image::prefetch_async(batch);
+  auto start = std::chrono::steady_clock::now();
+  assert(last->load_from_sd());
+  assert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(150));
+  // Fin du lot : toutes les images publiées, la dernière partage le buffer déjà chargé
+  int delivered = 0;
+  for (Image *image : batch)
+    image->add_on_load_callback([&delivered](bool ok) { delivered += ok; });
+  while (delivered < 10) {
+    Image::dispatch_prefetch_results();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  assert(batch[9]->get_sd_buffer() == last->get_sd_buffer());
+}
+
+// Les images avec leur propre lecteur ne partagent pas leurs pixels
+void test_private_reader_not_shared() {
+  Image *shared = make_image("/sd/private.jpg");
+  Image *own = make_image("/sd/private.jpg");
+  own->set_sd_file_reader(slow_reader);
+  assert(shared->load_from_sd() && own->load_from_sd());
+  assert(shared->get_sd_buffer() != own->get_sd_buffer());
+}
+
+}  // namespace
+
+int main() {
+  Image::set_global_sd_reader(slow_reader);
+  test_concurrent_loads_coalesce();
+  test_prefetch_callback_loads_later_key();
+  test_async_prefetch_does_not_hold_later_keys();
+  test_private_reader_not_shared();
+  printf("test_shared_buffers: OK\n");
+  return 0;
+}